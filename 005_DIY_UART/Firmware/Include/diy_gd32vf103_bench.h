@@ -0,0 +1,24 @@
+#ifndef DIY_GD32VF103_BENCH_H
+#define DIY_GD32VF103_BENCH_H
+
+#include "gd32vf103.h"
+
+/* number of iterations of every benchmark loop */
+#define DIY_BENCH_LOOPS               1000U
+
+/* pin descriptor (diy_gd32vf103_pin.h) every benchmark toggles, must be an output */
+#define DIY_BENCH_PIN                 DIY_BOARD_PIN(LED_BLUE)
+
+/* ECLIC sources borrowed for the ISR entry benchmark (CAN1 is unused on this board) */
+#define DIY_BENCH_IRQ_FLASH           CAN1_TX_IRQn                      /*!< vectored, handler in flash */
+#define DIY_BENCH_IRQ_RAM             CAN1_RX0_IRQn                     /*!< vectored, handler in SRAM */
+#define DIY_BENCH_IRQ_NON_VECTORED    CAN1_RX1_IRQn                     /*!< non-vectored, through irq_entry */
+
+// run all cycle benchmarks on DIY_BENCH_PIN and print them over USART0,
+// the ISR entry benchmarks need interrupts enabled globally
+void diy_bench_run(void);
+// time the GPIO configuration paths on a pin map, the table is applied as is,
+// so pass the configuration the pins already have
+void diy_bench_gpio_init(const gpio_init_parameter_struct *table, uint32_t count);
+
+#endif //DIY_GD32VF103_BENCH_H
@@ -0,0 +1,51 @@
+#ifndef DIY_GD32VF103_BOARD_H
+#define DIY_GD32VF103_BOARD_H
+
+#include "gd32vf103.h"
+
+/* board pin map: every pin the firmware uses is one row, written as
+       #define DIY_BOARD_ROW_<name>      port, pin, mode, speed, level, clock
+   port is the letter (A..E), pin the number (0..15), level the output level set before the
+   pin is switched to an output, clock the peripheral served by an alternate function pin.
+   diy_board_init() clocks the ports, applies the remaps and configures every pin in one
+   batched pass; diy_gd32vf103_board.c rejects a pin used twice or an AF pin without a clock */
+#define DIY_BOARD_NO_CLOCK            0U                                /*!< pin is not tied to a peripheral */
+
+#ifdef GD32VF103C_START
+/* name                                port pin mode                   speed              level clock */
+#define DIY_BOARD_ROW_USART0_TX        A,   9,  GPIO_MODE_AF_PP,       GPIO_OSPEED_50MHZ, 1,    RCU_USART0
+#define DIY_BOARD_ROW_USART0_RX        A,   10, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, 0,    RCU_USART0
+#define DIY_BOARD_ROW_LED_GREEN        A,   1,  GPIO_MODE_OUT_PP,      GPIO_OSPEED_2MHZ,  1,    DIY_BOARD_NO_CLOCK
+#define DIY_BOARD_ROW_LED_BLUE         A,   2,  GPIO_MODE_OUT_PP,      GPIO_OSPEED_2MHZ,  1,    DIY_BOARD_NO_CLOCK
+#define DIY_BOARD_ROW_LED_RED          C,   13, GPIO_MODE_OUT_PP,      GPIO_OSPEED_2MHZ,  1,    DIY_BOARD_NO_CLOCK
+#define DIY_BOARD_ROW_KEY              A,   0,  GPIO_MODE_IPD,         GPIO_OSPEED_2MHZ,  0,    DIY_BOARD_NO_CLOCK
+#define DIY_BOARD_ROW_STRIP            B,   0,  GPIO_MODE_OUT_PP,      GPIO_OSPEED_50MHZ, 0,    DIY_BOARD_NO_CLOCK
+
+// all rows, X(name) is expanded once per pin
+#define DIY_BOARD_PINS(X) \
+    X(USART0_TX) X(USART0_RX) X(LED_GREEN) X(LED_BLUE) X(LED_RED) X(KEY) X(STRIP)
+
+// AFIO remaps (gpio_pin_remap_config() values), X(remap) is expanded once per remap,
+// e.g. X(GPIO_USART0_REMAP) with the USART0 rows moved to PB6/PB7
+#define DIY_BOARD_REMAPS(X)
+#endif /* GD32VF103C_START */
+
+/* row access, F receives (name, port, pin, mode, speed, level, clock) */
+#define DIY_BOARD_ROW(F, name)        DIY_BOARD_ROW_(F, name, DIY_BOARD_ROW_##name)
+#define DIY_BOARD_ROW_(F, name, ...)  F(name, __VA_ARGS__)
+
+// pin descriptor for the DIY_PIN_* macros, e.g. DIY_PIN_SET(DIY_BOARD_PIN(LED_RED))
+#define DIY_BOARD_PIN(name)           DIY_BOARD_ROW(DIY_BOARD_PIN_, name)
+// pin number, for EXTI lines
+#define DIY_BOARD_LINE(name)          DIY_BOARD_ROW(DIY_BOARD_LINE_, name)
+
+#define DIY_BOARD_PIN_(name, port, pin, mode, speed, level, clock)   GPIO##port, GPIO_PIN_##pin
+#define DIY_BOARD_LINE_(name, port, pin, mode, speed, level, clock)  (pin##U)
+
+// clock the ports and peripherals of the pin map, apply the remaps, set the output levels
+// and configure all pins, one CTL write per port
+void diy_board_init(void);
+// the pin map as gpio_init_many() parameters
+const gpio_init_parameter_struct *diy_board_pins_get(uint32_t *count);
+
+#endif //DIY_GD32VF103_BOARD_H
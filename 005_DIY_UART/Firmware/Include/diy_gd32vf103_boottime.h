@@ -0,0 +1,29 @@
+#ifndef DIY_GD32VF103_BOOTTIME_H
+#define DIY_GD32VF103_BOOTTIME_H
+
+#include "gd32vf103.h"
+
+/* boot timing definitions */
+#define DIY_BOOT_IRC8M_MHZ            8U                                /*!< core clock until the switch to the PLL */
+
+/* mcycle stamps of the startup phases, field order is used by reset_handler */
+typedef struct {
+    uint32_t reset;       // first instruction of reset_handler
+    uint32_t mem_init;    // .data/.ramfunc copied, .bss zeroed (stack paint included)
+    uint32_t main_entry;  // first statement of main()
+    uint32_t clock_init;  // SystemInit() returned (HXTAL startup and PLL lock included)
+    uint32_t clock_ready; // fast boot only: CK_SYS switched by the RCU interrupt, 0 otherwise
+    uint32_t constructors; // C++ static objects built by .init_array (diy_gd32vf103_cxx.cpp), 0 if not
+}diy_boot_time_t;
+
+extern diy_boot_time_t diy_boot_time;
+
+// stamp the main() entry, call first thing in main
+#define DIY_BOOT_TIME_MARK_MAIN()     (diy_boot_time.main_entry = diy_cycle_get())
+// stamp the end of clock setup, call right after SystemInit()
+#define DIY_BOOT_TIME_MARK_CLOCK()    (diy_boot_time.clock_init = diy_cycle_get())
+
+// print the phase durations in cycles and microseconds over USART0
+void diy_boot_time_report(void);
+
+#endif //DIY_GD32VF103_BOOTTIME_H
@@ -0,0 +1,35 @@
+#ifndef DIY_GD32VF103_BUTTON_H
+#define DIY_GD32VF103_BUTTON_H
+
+#include "gd32vf103.h"
+
+/* button definitions */
+#define DIY_BUTTON_MAX                4U                                /*!< buttons handled at the same time */
+#define DIY_BUTTON_DEBOUNCE_MS        20U                               /*!< level must hold this long after an edge */
+#define DIY_BUTTON_LONG_MS            1000U                             /*!< held this long reports a long press */
+#define DIY_BUTTON_QUEUE_SIZE         8U                                /*!< pending events, power of two */
+
+/* events delivered to the main loop */
+typedef enum {
+    DIY_BUTTON_EVENT_NONE = 0,                                          /*!< queue empty */
+    DIY_BUTTON_EVENT_PRESS,                                             /*!< debounced press */
+    DIY_BUTTON_EVENT_RELEASE,                                           /*!< debounced release */
+    DIY_BUTTON_EVENT_LONG_PRESS,                                        /*!< still pressed after DIY_BUTTON_LONG_MS */
+}diy_button_event_enum;
+
+typedef struct {
+    uint8_t id;                   // value returned by diy_button_add()
+    diy_button_event_enum event;
+}diy_button_event_t;
+
+// watch pin 'line' (0..15) of 'gpio_periph', configured as an input by the caller,
+// 'active_high' is the level of a pressed button, returns the button id, or -1 when full or
+// when another button already uses EXTI line 'line'
+// uses EXTI for the edges and the systick for timing, so nothing runs while it is idle
+int32_t diy_button_add(uint32_t gpio_periph, uint32_t line, uint8_t active_high);
+// next event, DIY_BUTTON_EVENT_NONE in 'event' when there is none
+diy_button_event_t diy_button_event_get(void);
+// debounced state
+FlagStatus diy_button_pressed(uint8_t id);
+
+#endif //DIY_GD32VF103_BUTTON_H
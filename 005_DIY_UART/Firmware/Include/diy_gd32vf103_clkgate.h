@@ -0,0 +1,29 @@
+#ifndef DIY_GD32VF103_CLKGATE_H
+#define DIY_GD32VF103_CLKGATE_H
+
+#include "gd32vf103.h"
+
+/* clock gating definitions */
+#define DIY_CLKGATE_MAX               16U                               /*!< peripherals tracked at the same time */
+
+/* one gated peripheral clock, entries stay in the table once used so the time adds up */
+typedef struct {
+    rcu_periph_enum periph;   // RCU_GPIOA, RCU_USART0, ...
+    uint32_t refs;            // open users, the clock runs while this is not 0
+    uint32_t enabled_at;      // diy_systick_get() when the clock was last turned on
+    uint32_t enabled_ticks;   // on-time of the periods that already ended
+}diy_clkgate_entry_t;
+
+// take a reference, the first one turns the clock on, ERROR when the table is full
+ErrStatus diy_clkgate_acquire(rcu_periph_enum periph);
+// drop a reference, the last one turns the clock off, ERROR if 'periph' was not acquired
+ErrStatus diy_clkgate_release(rcu_periph_enum periph);
+// open users of 'periph'
+uint32_t diy_clkgate_refs_get(rcu_periph_enum periph);
+// total ticks 'periph' has been clocked, the running period included
+uint32_t diy_clkgate_enabled_ticks_get(rcu_periph_enum periph);
+
+// print every tracked clock with its users and on-time over USART0
+void diy_clkgate_report(void);
+
+#endif //DIY_GD32VF103_CLKGATE_H
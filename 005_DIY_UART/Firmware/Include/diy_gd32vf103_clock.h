@@ -0,0 +1,102 @@
+#ifndef DIY_GD32VF103_CLOCK_H
+#define DIY_GD32VF103_CLOCK_H
+
+#include "gd32vf103.h"
+
+/* clock change definitions */
+#define DIY_CLOCK_NOTIFIERS_MAX       4U                                /*!< registered drivers */
+#define DIY_CLOCK_SYS_MAX             108000000U                        /*!< CK_SYS / PLL output limit */
+#define DIY_CLOCK_APB1_MAX            54000000U                         /*!< CK_APB1 limit */
+#define DIY_CLOCK_ASYNC_IRQ_LEVEL     1U                                /*!< ECLIC level of the RCU stabilisation interrupt */
+#define DIY_CLOCK_ASYNC_TIMEOUT_MS    100U                              /*!< fast boot: wait this long for HXTAL/PLL before IRC8M */
+#define DIY_CLOCK_PLL_LOCK_TIMEOUT    0xFFFFU                           /*!< PLL/PLL1 stable flag polls before diy_clock_config_apply() gives up */
+#define DIY_CLOCK_SWITCH_TIMEOUT      0xFFFFU                           /*!< RCU_CFG0 SCSS reads before a CK_SYS switch gives up */
+
+/* PLL solver limits (kept to the ranges the GD reference configurations use) */
+#define DIY_CLOCK_PLL_IN_MIN          3000000U                          /*!< PLL input (PREDV0 output) */
+#define DIY_CLOCK_PLL_IN_MAX          12000000U
+#define DIY_CLOCK_PLL1_IN_MIN         3000000U                          /*!< PLL1 input (PREDV1 output) */
+#define DIY_CLOCK_PLL1_IN_MAX         5000000U
+#define DIY_CLOCK_PLL1_OUT_MIN        40000000U                         /*!< PLL1 output */
+#define DIY_CLOCK_PLL1_OUT_MAX        74000000U
+
+/* notifier events, 'hz' is the new core clock for both */
+#define DIY_CLOCK_EVENT_PRE           0U                                /*!< about to change, finish what depends on the old clock */
+#define DIY_CLOCK_EVENT_POST          1U                                /*!< changed, recompute dividers */
+
+typedef void (*diy_clock_notifier_t)(uint32_t event, uint32_t hz);
+
+/* clock fault codes, also written to the retained event log */
+#define DIY_CLOCK_LOG_HXTAL_FAIL      0x434B0001U                       /*!< HXTAL did not start, running from IRC8M */
+#define DIY_CLOCK_LOG_HXTAL_STUCK     0x434B0002U                       /*!< HXTAL stopped, clock monitor NMI */
+#define DIY_CLOCK_LOG_PLL_LOCK        0x434B0003U                       /*!< PLL or PLL1 did not lock */
+#define DIY_CLOCK_LOG_SWITCH_FAIL     0x434B0004U                       /*!< IRC8M did not start or CK_SYS did not switch */
+
+/* clock fault bookkeeping */
+typedef struct {
+    uint32_t hxtal_failures;  // HXTAL did not start (SystemInit or diy_clock_set)
+    uint32_t hxtal_stuck;     // HXTAL stopped while in use (clock monitor)
+    uint32_t pll_failures;    // PLL or PLL1 did not lock
+    uint32_t switch_failures; // IRC8M did not start or SCSS did not follow SCS
+    uint32_t last_code;       // DIY_CLOCK_LOG_* of the last fault
+    uint32_t last_tick;       // diy_systick_get() at the last fault
+}diy_clock_status_t;
+
+/* oscillator the solver builds the clock tree from */
+typedef enum {
+    DIY_CLOCK_SRC_IRC8M = 0,                                            /*!< IRC8M, or IRC8M/2 into the PLL */
+    DIY_CLOCK_SRC_HXTAL,                                                /*!< HXTAL, through PREDV0 and optionally PLL1 */
+}diy_clock_src_enum;
+
+/* stage at which diy_clock_config_apply() stopped */
+typedef enum {
+    DIY_CLOCK_APPLY_DONE = 0,                                           /*!< running from the new tree */
+    DIY_CLOCK_APPLY_HXTAL_FAIL,                                         /*!< HXTAL did not start, nothing changed */
+    DIY_CLOCK_APPLY_IRC8M_FAIL,                                         /*!< IRC8M did not start, nothing changed */
+    DIY_CLOCK_APPLY_PLL_FAIL,                                           /*!< a PLL did not lock, left on IRC8M with the PLLs off */
+    DIY_CLOCK_APPLY_SWITCH_FAIL,                                        /*!< CK_SYS did not switch, SCS pointed back at IRC8M */
+}diy_clock_apply_enum;
+
+/* solved clock tree, ready to be written to RCU_CFG0/RCU_CFG1 */
+typedef struct {
+    uint32_t hz;          // resulting CK_SYS
+    uint32_t scs;         // RCU_CKSYSSRC_IRC8M/HXTAL/PLL
+    uint32_t cfg0;        // PLLSEL, PLLMF and PLLMF_4 bits
+    uint32_t cfg1;        // PREDV0SEL, PREDV0, PREDV1 and PLL1MF bits
+}diy_clock_config_t;
+
+// find an exact PREDV1/PLL1MF/PREDV0/PLLMF chain from 'src' to 'target_hz'
+ErrStatus diy_clock_solve(diy_clock_src_enum src, uint32_t target_hz, diy_clock_config_t *config);
+// program a solved clock tree (parks on IRC8M while the PLLs relock), returns the stage it stopped at
+// the HXTAL clock monitor is enabled whenever the tree runs from HXTAL
+diy_clock_apply_enum diy_clock_config_apply(const diy_clock_config_t *config);
+
+// fast boot: start the oscillators of 'config' and return on IRC8M, RCU_CTC_IRQHandler switches
+// CK_SYS over once they are stable (drivers get PRE/POST notifications as for diy_clock_set)
+ErrStatus diy_clock_async_start(const diy_clock_config_t *config);
+// call once the ECLIC and the tick run: hooks the clock monitor recovery and the fast-boot timeout
+// into the tick, and unmasks the RCU interrupt of a fast-boot switch in progress
+void diy_clock_irq_enable(void);
+// SET until the fast-boot switch (or its IRC8M fallback) has happened
+FlagStatus diy_clock_async_pending(void);
+
+// applying 'config' stopped at 'stage': record the fault, then run from the fastest IRC8M
+// configuration if 'config' used HXTAL, or stay on IRC8M with the PLLs off if it did not
+void diy_clock_fallback(const diy_clock_config_t *config, diy_clock_apply_enum stage);
+// clock monitor NMI, SUCCESS if the NMI was an HXTAL stuck event; only counts and flags it, the
+// next tick moves to the fastest IRC8M tree with PRE/POST notifications and logs the fault
+ErrStatus diy_clock_ckm_handler(void);
+// fault counters
+const diy_clock_status_t *diy_clock_status_get(void);
+
+// register a driver to be told about core clock changes
+ErrStatus diy_clock_notifier_add(diy_clock_notifier_t notifier);
+// switch the core clock at run time: IRC8M directly for IRC8M_VALUE, otherwise from HXTAL if it can
+// be reached exactly, IRC8M otherwise
+ErrStatus diy_clock_set(uint32_t target_hz);
+// current core clock
+uint32_t diy_clock_get(void);
+// clock of the timers on CK_APB1 or CK_APB2, twice the bus clock when the bus prescaler divides
+uint32_t diy_clock_timer_get(rcu_clock_freq_enum bus);
+
+#endif //DIY_GD32VF103_CLOCK_H
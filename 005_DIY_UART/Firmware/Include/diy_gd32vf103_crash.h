@@ -0,0 +1,38 @@
+#ifndef DIY_GD32VF103_CRASH_H
+#define DIY_GD32VF103_CRASH_H
+
+#include "gd32vf103.h"
+
+/* crash record definitions */
+#define DIY_CRASH_MAGIC               0x48535243U                       /*!< "CRSH", record is valid */
+#define DIY_CRASH_VERSION             1U
+
+/* mcause fields (ECLIC mode) */
+#define MCAUSE_INTERRUPT              BIT(31)                           /*!< trap was an interrupt */
+#define MCAUSE_EXCCODE                BITS(0,11)                        /*!< exception code / interrupt id */
+#define MCAUSE_EXCCODE_NMI            0x00000FFFU                       /*!< non-maskable interrupt */
+
+/* binary crash record, a retained block that survives the reset following the trap */
+typedef struct {
+    diy_retain_header_t header;   // magic DIY_CRASH_MAGIC, CRC over the rest
+    uint32_t version;     // DIY_CRASH_VERSION
+    uint32_t count;       // crashes since the last report
+    uint32_t tick;        // diy_systick_get() at the trap
+    uint32_t mcause;
+    uint32_t mepc;
+    uint32_t mtval;
+    uint32_t mstatus;
+    uint32_t msubm;
+    uint32_t regs[32];    // x0..x31 at the trap, x2 is the interrupted sp
+}diy_crash_record_t;
+
+// called by trap_entry with the saved register file, stores the record and resets
+void diy_crash_handler(uint32_t *regs);
+// called by trap_entry for an NMI, SUCCESS resumes the interrupted code
+ErrStatus diy_nmi_handler(void);
+// stream a pending record over USART0 (binary, then a decoded text line) and clear it
+ErrStatus diy_crash_report(void);
+// text name of an mcause value
+char *diy_crash_cause_name(uint32_t mcause);
+
+#endif //DIY_GD32VF103_CRASH_H
@@ -0,0 +1,20 @@
+#ifndef DIY_GD32VF103_CRC_H
+#define DIY_GD32VF103_CRC_H
+
+#include "gd32vf103.h"
+
+/* CRC definitions */
+#define CRC                           CRC_BASE
+
+/* CRC registers definitions */
+#define CRC_DATA                      REG32(CRC + 0x00000000U)          /*!< CRC data register */
+#define CRC_FDATA                     REG32(CRC + 0x00000004U)          /*!< CRC free data register */
+#define CRC_CTL                       REG32(CRC + 0x00000008U)          /*!< CRC control register */
+
+/* CRC_CTL */
+#define CRC_CTL_RST                   BIT(0)                            /*!< reset the CRC data register to 0xFFFFFFFF */
+
+// CRC-32 (0x04C11DB7, init 0xFFFFFFFF, word-wise) of 'words' 32-bit words on the CRC unit
+uint32_t diy_crc32_calc(const uint32_t *data, uint32_t words);
+
+#endif //DIY_GD32VF103_CRC_H
@@ -0,0 +1,85 @@
+#ifndef DIY_GD32VF103_CSR_H
+#define DIY_GD32VF103_CSR_H
+
+#include <stdint.h>
+
+/* RISC-V / Bumblebee (N200) CSR numbers */
+#define CSR_MSTATUS                   0x300                             /*!< machine status register */
+#define CSR_MTVEC                     0x305                             /*!< machine trap vector base address */
+#define CSR_MTVT                      0x307                             /*!< ECLIC vector table base address (N200 specific) */
+#define CSR_MEPC                      0x341                             /*!< machine exception program counter */
+#define CSR_MCAUSE                    0x342                             /*!< machine trap cause */
+#define CSR_MTVAL                     0x343                             /*!< machine bad address or instruction */
+#define CSR_MSUBM                     0x7C4                             /*!< machine sub-mode (N200 specific) */
+#define CSR_MCOUNTINHIBIT             0x320                             /*!< counter inhibit register */
+#define CSR_MCYCLE                    0xB00                             /*!< cycle counter, low word */
+#define CSR_MINSTRET                  0xB02                             /*!< retired instruction counter, low word */
+#define CSR_MCYCLEH                   0xB80                             /*!< cycle counter, high word */
+#define CSR_MINSTRETH                 0xB82                             /*!< retired instruction counter, high word */
+
+/* MSTATUS bits */
+#define MSTATUS_MIE                   0x00000008U                       /*!< machine interrupt enable */
+
+/* MCOUNTINHIBIT bits */
+#define MCOUNTINHIBIT_CY              0x00000001U                       /*!< stop mcycle */
+#define MCOUNTINHIBIT_IR              0x00000004U                       /*!< stop minstret */
+
+/* CSR access macros, reg can be a CSR name (mstatus) or number (CSR_MCYCLE) */
+#define CSR_STR_(x)                   #x
+#define CSR_STR(x)                    CSR_STR_(x)
+
+#ifdef DIY_HOST_TEST
+/* host tests (make host-test) have no CSRs: reads return 0, writes are dropped */
+#define read_csr(reg)       (0U)
+#define write_csr(reg, val) ((void)(val))
+#define set_csr(reg, bit)   ((void)(bit))
+#define clear_csr(reg, bit) ((void)(bit))
+#else
+#define read_csr(reg)       ({ uint32_t __v; \
+                               __asm__ volatile ("csrr %0, " CSR_STR(reg) : "=r"(__v) :: "memory"); \
+                               __v; })
+#define write_csr(reg, val) ({ __asm__ volatile ("csrw " CSR_STR(reg) ", %0" :: "rK"(val) : "memory"); })
+#define set_csr(reg, bit)   ({ __asm__ volatile ("csrs " CSR_STR(reg) ", %0" :: "rK"(bit) : "memory"); })
+#define clear_csr(reg, bit) ({ __asm__ volatile ("csrc " CSR_STR(reg) ", %0" :: "rK"(bit) : "memory"); })
+#endif
+
+// cycle counter, low 32 bits (wraps every ~40 s at 108 MHz)
+static inline uint32_t diy_cycle_get(void)
+{
+    return read_csr(CSR_MCYCLE);
+}
+
+// full 64-bit cycle counter, re-reads the high word if the low word wrapped
+static inline uint64_t diy_cycle_get64(void)
+{
+    uint32_t hi, lo;
+
+    do {
+        hi = read_csr(CSR_MCYCLEH);
+        lo = read_csr(CSR_MCYCLE);
+    } while (hi != read_csr(CSR_MCYCLEH));
+
+    return ((uint64_t)hi << 32) | lo;
+}
+
+// global interrupt masking for short critical sections
+static inline uint32_t diy_irq_save(void)
+{
+    uint32_t mstatus;
+
+#ifdef DIY_HOST_TEST
+    mstatus = 0U;
+#else
+    __asm__ volatile ("csrrci %0, mstatus, 8" : "=r"(mstatus) :: "memory");
+#endif
+    return mstatus & MSTATUS_MIE;
+}
+
+static inline void diy_irq_restore(uint32_t state)
+{
+    if (state) {
+        set_csr(mstatus, MSTATUS_MIE);
+    }
+}
+
+#endif //DIY_GD32VF103_CSR_H
@@ -0,0 +1,37 @@
+#ifndef DIY_GD32VF103_DMA_H
+#define DIY_GD32VF103_DMA_H
+
+#include "gd32vf103.h"
+
+/* DMA0 definitions, channel x registers are 0x14 apart */
+#define DMA0                          (DMA_BASE + 0x00000000U)
+
+/* DMA0 registers definitions */
+#define DMA0_INTF                     REG32(DMA0 + 0x00000000U)         /*!< interrupt flag register */
+#define DMA0_INTC                     REG32(DMA0 + 0x00000004U)         /*!< interrupt flag clear register */
+#define DMA0_CHCTL(ch)                REG32(DMA0 + 0x00000008U + 0x14U * (ch))  /*!< channel control register */
+#define DMA0_CHCNT(ch)                REG32(DMA0 + 0x0000000CU + 0x14U * (ch))  /*!< channel counter register */
+#define DMA0_CHPADDR(ch)              REG32(DMA0 + 0x00000010U + 0x14U * (ch))  /*!< channel peripheral address register */
+#define DMA0_CHMADDR(ch)              REG32(DMA0 + 0x00000014U + 0x14U * (ch))  /*!< channel memory address register */
+
+/* DMA bits definitions */
+#define DMA_INTF_GIF(ch)              BIT(4U * (ch))                    /*!< channel global interrupt flag */
+#define DMA_INTF_FTFIF(ch)            BIT(4U * (ch) + 1U)               /*!< channel full transfer finish flag */
+#define DMA_INTF_HTFIF(ch)            BIT(4U * (ch) + 2U)               /*!< channel half transfer finish flag */
+#define DMA_INTF_ERRIF(ch)            BIT(4U * (ch) + 3U)               /*!< channel error flag */
+#define DMA_CHCTL_CHEN                BIT(0)                            /*!< channel enable */
+#define DMA_CHCTL_FTFIE               BIT(1)                            /*!< full transfer finish interrupt enable */
+#define DMA_CHCTL_HTFIE               BIT(2)                            /*!< half transfer finish interrupt enable */
+#define DMA_CHCTL_ERRIE               BIT(3)                            /*!< error interrupt enable */
+#define DMA_CHCTL_DIR                 BIT(4)                            /*!< memory to peripheral */
+#define DMA_CHCTL_CMEN                BIT(5)                            /*!< circular mode */
+#define DMA_CHCTL_PNAGA               BIT(6)                            /*!< peripheral address increments */
+#define DMA_CHCTL_MNAGA               BIT(7)                            /*!< memory address increments */
+#define DMA_CHCTL_PWIDTH_16BIT        (1U << 8)                         /*!< 16-bit peripheral transfers */
+#define DMA_CHCTL_PWIDTH_32BIT        (2U << 8)                         /*!< 32-bit peripheral transfers */
+#define DMA_CHCTL_MWIDTH_16BIT        (1U << 10)                        /*!< 16-bit memory transfers */
+#define DMA_CHCTL_MWIDTH_32BIT        (2U << 10)                        /*!< 32-bit memory transfers */
+#define DMA_CHCTL_PRIO_HIGH           (2U << 12)                        /*!< high channel priority */
+#define DMA_CHCTL_PRIO_ULTRA_HIGH     (3U << 12)                        /*!< highest channel priority */
+
+#endif //DIY_GD32VF103_DMA_H
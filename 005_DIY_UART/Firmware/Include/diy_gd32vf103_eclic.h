@@ -0,0 +1,82 @@
+#ifndef DIY_GD32VF103_ECLIC_H
+#define DIY_GD32VF103_ECLIC_H
+
+#include "gd32vf103.h"
+
+/* ECLIC definitions */
+#define ECLIC_BASE                    ((uint32_t)0xD2000000U)           /*!< ECLIC base address */
+
+/* ECLIC registers definitions */
+#define ECLIC_CFG                     REG8(ECLIC_BASE + 0x00000000U)    /*!< ECLIC configuration register */
+#define ECLIC_INFO                    REG32(ECLIC_BASE + 0x00000004U)   /*!< ECLIC information register */
+#define ECLIC_MTH                     REG8(ECLIC_BASE + 0x0000000BU)    /*!< ECLIC machine mode threshold register */
+#define ECLIC_INT_IP(irq)             REG8(ECLIC_BASE + 0x00001000U + 4U*(uint32_t)(irq))   /*!< interrupt pending */
+#define ECLIC_INT_IE(irq)             REG8(ECLIC_BASE + 0x00001001U + 4U*(uint32_t)(irq))   /*!< interrupt enable */
+#define ECLIC_INT_ATTR(irq)           REG8(ECLIC_BASE + 0x00001002U + 4U*(uint32_t)(irq))   /*!< interrupt attribute */
+#define ECLIC_INT_CTL(irq)            REG8(ECLIC_BASE + 0x00001003U + 4U*(uint32_t)(irq))   /*!< interrupt level and priority */
+
+/* ECLIC_CFG */
+#define ECLIC_CFG_NLBITS              BITS(1,4)                         /*!< number of level bits in ECLIC_INT_CTL */
+
+/* ECLIC_INFO */
+#define ECLIC_INFO_CTLBITS            BITS(21,24)                       /*!< implemented bits in ECLIC_INT_CTL */
+
+/* ECLIC_INT_IP / ECLIC_INT_IE */
+#define ECLIC_INT_IP_IP               BIT(0)                            /*!< interrupt pending */
+#define ECLIC_INT_IE_IE               BIT(0)                            /*!< interrupt enable */
+
+/* ECLIC_INT_ATTR */
+#define ECLIC_INT_ATTR_SHV            BIT(0)                            /*!< selective hardware vectoring */
+#define ECLIC_INT_ATTR_TRIG           BITS(1,2)                         /*!< trigger type */
+
+/* constants definitions */
+/* number of implemented ECLIC_INT_CTL bits (upper bits of the register) */
+#define ECLIC_CTLBITS                 4U
+
+/* ECLIC priority group: level bits / priority bits split of the ECLIC_INT_CTL bits */
+#define CFG_NLBITS(regval)            (BITS(1,4) & ((uint32_t)(regval) << 1))
+#define ECLIC_PRIGROUP_LEVEL0_PRIO4   CFG_NLBITS(0)                     /*!< 0 level bits, 4 priority bits */
+#define ECLIC_PRIGROUP_LEVEL1_PRIO3   CFG_NLBITS(1)                     /*!< 1 level bit, 3 priority bits */
+#define ECLIC_PRIGROUP_LEVEL2_PRIO2   CFG_NLBITS(2)                     /*!< 2 level bits, 2 priority bits */
+#define ECLIC_PRIGROUP_LEVEL3_PRIO1   CFG_NLBITS(3)                     /*!< 3 level bits, 1 priority bit */
+#define ECLIC_PRIGROUP_LEVEL4_PRIO0   CFG_NLBITS(4)                     /*!< 4 level bits, 0 priority bits */
+
+/* ECLIC trigger type */
+#define ATTR_TRIG(regval)             (BITS(1,2) & ((uint32_t)(regval) << 1))
+#define ECLIC_TRIGGER_LEVEL           ATTR_TRIG(0)                      /*!< level triggered */
+#define ECLIC_TRIGGER_RISING          ATTR_TRIG(1)                      /*!< rising edge triggered */
+#define ECLIC_TRIGGER_FALLING         ATTR_TRIG(3)                      /*!< falling edge triggered */
+
+/* ECLIC dispatch mode */
+typedef enum {
+    ECLIC_MODE_NON_VECTORED = 0,     /*!< through irq_entry, handler is a plain C function */
+    ECLIC_MODE_VECTORED              /*!< straight from the vector table, handler must be __INTERRUPT */
+}eclic_mode_enum;
+
+/* attribute for handlers of vectored sources: saves its own context and returns with mret
+   (empty in the host tests, where the attribute means an x86 interrupt frame) */
+#ifdef DIY_HOST_TEST
+#define __INTERRUPT
+#else
+#define __INTERRUPT                   __attribute__((interrupt))
+#endif
+
+// initialization functions
+void diy_eclic_init(void);
+void diy_eclic_priority_group_set(uint32_t prigroup);
+void diy_eclic_threshold_set(uint8_t level);
+
+// per source configuration
+void diy_eclic_irq_enable(IRQn_Type irq, uint8_t level, uint8_t priority);
+void diy_eclic_irq_disable(IRQn_Type irq);
+void diy_eclic_level_priority_set(IRQn_Type irq, uint8_t level, uint8_t priority);
+void diy_eclic_mode_set(IRQn_Type irq, eclic_mode_enum mode);
+void diy_eclic_trigger_set(IRQn_Type irq, uint32_t trigger);
+void diy_eclic_pending_set(IRQn_Type irq);
+void diy_eclic_pending_clear(IRQn_Type irq);
+
+// global interrupt enable (mstatus.MIE)
+void diy_eclic_global_interrupt_enable(void);
+void diy_eclic_global_interrupt_disable(void);
+
+#endif //DIY_GD32VF103_ECLIC_H
@@ -0,0 +1,40 @@
+#ifndef DIY_GD32VF103_EXTI_H
+#define DIY_GD32VF103_EXTI_H
+
+#include "gd32vf103.h"
+
+/* EXTI definitions */
+#define EXTI                          EXTI_BASE
+
+/* EXTI registers definitions */
+#define EXTI_INTEN                    REG32(EXTI + 0x00000000U)         /*!< interrupt enable register */
+#define EXTI_EVEN                     REG32(EXTI + 0x00000004U)         /*!< event enable register */
+#define EXTI_RTEN                     REG32(EXTI + 0x00000008U)         /*!< rising edge trigger enable register */
+#define EXTI_FTEN                     REG32(EXTI + 0x0000000CU)         /*!< falling edge trigger enable register */
+#define EXTI_SWIEV                    REG32(EXTI + 0x00000010U)         /*!< software interrupt event register */
+#define EXTI_PD                       REG32(EXTI + 0x00000014U)         /*!< pending register, write 1 to clear */
+
+/* constants definitions */
+#define DIY_EXTI_GPIO_LINES           16U                               /*!< lines 0..15 follow the GPIO pin number */
+#define DIY_EXTI_IRQ_LEVEL            1U                                /*!< ECLIC level of the EXTI interrupts */
+
+/* edges that raise the interrupt */
+typedef enum {
+    DIY_EXTI_TRIG_RISING = 1,
+    DIY_EXTI_TRIG_FALLING = 2,
+    DIY_EXTI_TRIG_BOTH = 3,
+}diy_exti_trig_enum;
+
+// called from the EXTI interrupt with the line number, the pending bit is already cleared
+typedef void (*diy_exti_handler_t)(uint32_t line);
+
+// route pin 'line' (0..15) of 'gpio_periph' to its EXTI line, select the edges and enable
+// the line and its ECLIC source (EXTI0..4, EXTI5_9 or EXTI10_15), ERROR for a bad line
+ErrStatus diy_exti_init(uint32_t gpio_periph, uint32_t line, diy_exti_trig_enum trig, diy_exti_handler_t handler);
+// mask / unmask a line, edges while masked only set the pending bit
+void diy_exti_enable(uint32_t line);
+void diy_exti_disable(uint32_t line);
+FlagStatus diy_exti_pending_get(uint32_t line);
+void diy_exti_pending_clear(uint32_t line);
+
+#endif //DIY_GD32VF103_EXTI_H
@@ -0,0 +1,49 @@
+#ifndef DIY_GD32VF103_HEAP_H
+#define DIY_GD32VF103_HEAP_H
+
+#include "gd32vf103.h"
+
+/* alignment of every block handed out by the heap, pools and arenas */
+#define DIY_HEAP_ALIGN                8U
+#define DIY_HEAP_ALIGN_UP(size)       (((uint32_t)(size) + (DIY_HEAP_ALIGN - 1U)) & ~(DIY_HEAP_ALIGN - 1U))
+
+/* fixed-size block pool, O(1) alloc/free through an intrusive free list */
+typedef struct {
+    void *free_list;      // first free block, NULL when exhausted
+    uint8_t *storage;     // block_count * block_size bytes taken from the heap, bitmap after them
+    uint32_t *allocated;  // one bit per block, set while it is handed out
+    uint16_t block_size;  // rounded up to DIY_HEAP_ALIGN
+    uint16_t block_count;
+    uint16_t used;        // blocks currently allocated
+    uint16_t peak;        // high-water mark of used
+    uint32_t fail_count;  // allocations refused because the pool was empty
+    uint32_t bad_frees;   // frees refused: foreign or misaligned pointer, or double free
+}diy_pool_t;
+
+/* bump-pointer arena, freed all at once with mark/reset */
+typedef struct {
+    uint8_t *base;
+    uint32_t size;
+    uint32_t offset;      // bytes in use
+    uint32_t peak;        // high-water mark of offset
+    uint32_t fail_count;  // allocations refused because the arena was full
+}diy_arena_t;
+
+// heap region between _end and _heap_end (see gd32vf103xb.ld), carved out once and never freed
+void *diy_heap_reserve(uint32_t size);
+uint32_t diy_heap_size_get(void);
+uint32_t diy_heap_free_get(void);
+
+// fixed-block pool
+ErrStatus diy_pool_init(diy_pool_t *pool, uint32_t block_size, uint32_t block_count);
+void *diy_pool_alloc(diy_pool_t *pool);
+// ERROR (and bad_frees counted, the pool untouched) if block is not an allocated block of this pool
+ErrStatus diy_pool_free(diy_pool_t *pool, void *block);
+
+// arena
+ErrStatus diy_arena_init(diy_arena_t *arena, uint32_t size);
+void *diy_arena_alloc(diy_arena_t *arena, uint32_t size);
+uint32_t diy_arena_mark(diy_arena_t *arena);
+void diy_arena_reset(diy_arena_t *arena, uint32_t mark);
+
+#endif //DIY_GD32VF103_HEAP_H
@@ -0,0 +1,34 @@
+#ifndef DIY_GD32VF103_IRCTRIM_H
+#define DIY_GD32VF103_IRCTRIM_H
+
+#include "gd32vf103.h"
+
+/* PMU definitions, only the backup domain write enable is needed here */
+#define PMU_CTL                       REG32(PMU_BASE + 0x00000000U)     /*!< PMU control register */
+#define PMU_CTL_BKPWEN                BIT(8)                            /*!< backup domain write enable */
+
+/* trimming definitions */
+#define DIY_IRCTRIM_CAPTURE_DIV       8U                                /*!< LXTAL periods per capture (TIMER_CHCTL1_CH3CAPPSC_DIV8) */
+#define DIY_IRCTRIM_WINDOW            256U                              /*!< captures per measurement, 62.5 ms of LXTAL */
+#define DIY_IRCTRIM_STEP_PPM          5000                              /*!< one IRC8MADJ step moves IRC8M by about 40 kHz */
+#define DIY_IRCTRIM_ADJ_MAX           31U                               /*!< IRC8MADJ is 5 bits, 16 is the factory centre */
+#define DIY_IRCTRIM_IRQ_LEVEL         1U                                /*!< ECLIC level of the capture interrupt */
+
+/* trimming state */
+typedef struct {
+    uint32_t trim;        // IRC8MADJ in use
+    int32_t error_ppm;    // last measured IRC8M error against LXTAL, before the correction
+    uint32_t windows;     // measurements taken while running from IRC8M
+    uint32_t adjustments; // trim steps taken
+}diy_irctrim_status_t;
+
+// start LXTAL and the TIMER4 capture, IRC8M is trimmed from the capture interrupt from then on
+// returns at once: the crystal may need a second or more, measurements start when it is stable
+void diy_irctrim_init(void);
+// clock change notifier (diy_clock_notifier_add), drops the measurement in progress
+void diy_irctrim_clock_notify(uint32_t event, uint32_t hz);
+// SET once LXTAL runs
+FlagStatus diy_irctrim_lxtal_ready(void);
+const diy_irctrim_status_t *diy_irctrim_status_get(void);
+
+#endif //DIY_GD32VF103_IRCTRIM_H
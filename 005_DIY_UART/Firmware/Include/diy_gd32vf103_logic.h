@@ -0,0 +1,37 @@
+#ifndef DIY_GD32VF103_LOGIC_H
+#define DIY_GD32VF103_LOGIC_H
+
+#include "gd32vf103.h"
+
+/* capture definitions */
+#define DIY_LOGIC_DMA_CH              2U                                /*!< DMA0 channel 2 carries the TIMER2_UP request */
+#define DIY_LOGIC_TX_DMA_CH           3U                                /*!< DMA0 channel 3 carries the USART0_TX request */
+#define DIY_LOGIC_HALF_SAMPLES        512U                              /*!< samples per half buffer */
+#define DIY_LOGIC_OUT_BYTES           1024U                             /*!< output ring for USART0, a power of two */
+#define DIY_LOGIC_RECORD_MAX          7U                                /*!< longest record: 2 value bytes and a 5 byte run */
+#define DIY_LOGIC_RATE_MAX            1000000U                          /*!< highest sample rate in Hz */
+#define DIY_LOGIC_IRQ_LEVEL           1U                                /*!< ECLIC level of the half buffer and TX interrupts */
+
+/* stream format, after a text line "Logic: ..." on USART0:
+   records of the masked GPIO_ISTAT value (2 bytes, little endian) followed by the number
+   of samples it lasted (LEB128, 7 bits per byte, low bits first, bit 7 = more);
+   a record with a length of 0 ends the stream, a text line with the result follows */
+
+/* capture states */
+typedef enum {
+    DIY_LOGIC_IDLE = 0,       // nothing started
+    DIY_LOGIC_RUNNING,        // sampling, diy_logic_poll() has work to do
+    DIY_LOGIC_DONE,           // all samples sent
+    DIY_LOGIC_OVERRUN         // output ring full (USART0 slower than the stream) or a stalled poll, capture stopped
+}diy_logic_state_enum;
+
+// sample GPIO_ISTAT of gpio_periph at rate_hz with TIMER2 + DMA0 into a double buffer, returns at once
+// ERROR if the rate cannot be reached or a capture is running
+ErrStatus diy_logic_start(uint32_t gpio_periph, uint16_t mask, uint32_t rate_hz, uint32_t samples);
+// compress the filled halves into the output ring, USART0 TX DMA sends it; call from the main loop
+// until it stops returning RUNNING, USART0 must not be written directly before then
+diy_logic_state_enum diy_logic_poll(void);
+// rate the timer actually runs at, rate_hz rounded to the timer clock
+uint32_t diy_logic_rate_get(void);
+
+#endif //DIY_GD32VF103_LOGIC_H
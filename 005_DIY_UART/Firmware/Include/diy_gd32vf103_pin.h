@@ -0,0 +1,43 @@
+#ifndef DIY_GD32VF103_PIN_H
+#define DIY_GD32VF103_PIN_H
+
+#include "gd32vf103.h"
+
+/* pin descriptors: a pin is the pair "GPIOx, GPIO_PIN_y", named once per board, e.g.
+       #define LED_RED                   GPIOC, GPIO_PIN_13
+   the operations below expand the pair in place, so with constant descriptors every
+   access is a single load/store to a constant address, even at -O0 */
+
+// split a descriptor
+#define DIY_PIN_PORT(pin)             DIY_PIN_PORT_(pin)
+#define DIY_PIN_MASK(pin)             DIY_PIN_MASK_(pin)
+
+// drive high / low, one BOP or BC store
+#define DIY_PIN_SET(pin)              DIY_PIN_SET_(pin)
+#define DIY_PIN_RESET(pin)            DIY_PIN_RESET_(pin)
+// drive to 'value' (0 or not 0), one BOP store (the upper half of BOP clears)
+#define DIY_PIN_WRITE(pin, value)     DIY_PIN_WRITE_(pin, value)
+// BOP word that drives the pin to 'value', OR the words of pins on the same port
+// and store them with GPIO_BOP() to change all of them at the same instant
+#define DIY_PIN_BOP_BITS(pin, value)  DIY_PIN_BOP_BITS_(pin, value)
+// invert the output, one OCTL load and one BOP store, no read-modify-write of OCTL
+#define DIY_PIN_TOGGLE(pin)           DIY_PIN_TOGGLE_(pin)
+// input level / driven output level, SET or RESET
+#define DIY_PIN_GET(pin)              DIY_PIN_GET_(pin)
+#define DIY_PIN_OUTPUT_GET(pin)       DIY_PIN_OUTPUT_GET_(pin)
+
+/* the second level receives the descriptor already split into port and mask */
+#define DIY_PIN_PORT_(port, mask)     (port)
+#define DIY_PIN_MASK_(port, mask)     ((uint32_t)(mask))
+#define DIY_PIN_SET_(port, mask)      (GPIO_BOP(port) = (uint32_t)(mask))
+#define DIY_PIN_RESET_(port, mask)    (GPIO_BC(port) = (uint32_t)(mask))
+#define DIY_PIN_BOP_BITS_(port, mask, value) \
+    ((value) ? (uint32_t)(mask) : ((uint32_t)(mask) << 16))
+#define DIY_PIN_WRITE_(port, mask, value) \
+    (GPIO_BOP(port) = DIY_PIN_BOP_BITS_(port, mask, value))
+#define DIY_PIN_TOGGLE_(port, mask) \
+    (GPIO_BOP(port) = (GPIO_OCTL(port) & (uint32_t)(mask)) ? ((uint32_t)(mask) << 16) : (uint32_t)(mask))
+#define DIY_PIN_GET_(port, mask)      ((GPIO_ISTAT(port) & (uint32_t)(mask)) ? SET : RESET)
+#define DIY_PIN_OUTPUT_GET_(port, mask) ((GPIO_OCTL(port) & (uint32_t)(mask)) ? SET : RESET)
+
+#endif //DIY_GD32VF103_PIN_H
@@ -0,0 +1,57 @@
+#ifndef DIY_GD32VF103_RETAIN_H
+#define DIY_GD32VF103_RETAIN_H
+
+#include "gd32vf103.h"
+
+/* retained block definitions */
+#define DIY_RETAIN_MAGIC              0x4E544552U                       /*!< "RETN", block is valid */
+#define DIY_RETAIN_LOG_SIZE           8U                                /*!< entries in the retained event log */
+
+/* reset cause, latched from RCU_RSTSCK on the first call */
+typedef enum {
+    DIY_RESET_POWER = 0,                                                /*!< power-on / brown-out, RAM content is lost */
+    DIY_RESET_LOWPOWER,                                                 /*!< low-power reset */
+    DIY_RESET_PIN,                                                      /*!< NRST pin */
+    DIY_RESET_SOFTWARE,                                                 /*!< core software reset */
+    DIY_RESET_FWDGT,                                                    /*!< free watchdog timer */
+    DIY_RESET_WWDGT,                                                    /*!< window watchdog timer */
+}diy_reset_cause_enum;
+
+/* header at the start of every retained block, the rest must be whole words */
+typedef struct {
+    uint32_t magic;       // DIY_RETAIN_MAGIC (or a block specific value)
+    uint32_t length;      // sizeof the whole block, catches layout changes
+    uint32_t crc;         // diy_crc32_calc() over the payload after the header
+}diy_retain_header_t;
+
+/* system retained block: counters and a small event log */
+typedef struct {
+    diy_retain_header_t header;
+    uint32_t boot_count;                  // resets since the block was created
+    uint32_t warm_count;                  // resets that kept the RAM content
+    uint32_t log_index;                   // next log slot
+    uint32_t log[DIY_RETAIN_LOG_SIZE];    // event codes, oldest is overwritten
+}diy_retain_sys_t;
+
+// check magic, length and CRC of a retained block of 'size' bytes
+ErrStatus diy_retain_check(diy_retain_header_t *header, uint32_t size, uint32_t magic);
+// update the header of a retained block after its payload was changed
+void diy_retain_commit(diy_retain_header_t *header, uint32_t size, uint32_t magic);
+// mark a retained block invalid
+void diy_retain_invalidate(diy_retain_header_t *header);
+
+// reset cause of this boot, RCU reset flags are cleared on the first call
+diy_reset_cause_enum diy_reset_cause_get(void);
+char *diy_reset_cause_name(diy_reset_cause_enum cause);
+// SUCCESS if the retained RAM survived the last reset (warm reset)
+ErrStatus diy_retain_warm_get(void);
+
+// system block, validated (or recreated) by diy_retain_init()
+void diy_retain_init(void);
+diy_retain_sys_t *diy_retain_sys_get(void);
+void diy_retain_log_add(uint32_t code);
+
+// software reset of the whole chip, retained RAM is kept
+void diy_system_reset(void);
+
+#endif //DIY_GD32VF103_RETAIN_H
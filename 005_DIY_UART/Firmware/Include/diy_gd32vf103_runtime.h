@@ -0,0 +1,18 @@
+#ifndef DIY_GD32VF103_RUNTIME_H
+#define DIY_GD32VF103_RUNTIME_H
+
+#include "gd32vf103.h"
+
+/* runtime definitions */
+typedef void (*diy_runtime_func_t)(void);
+
+// run .preinit_array then .init_array (C++ static constructors), called by reset_handler before main
+void diy_runtime_init(void);
+// run .fini_array in reverse order, called by reset_handler if main returns
+void diy_runtime_fini(void);
+
+// minimal C++ ABI support, weak so a full runtime can replace it
+void __cxa_pure_virtual(void);
+int __cxa_atexit(void (*func)(void *), void *arg, void *dso);
+
+#endif //DIY_GD32VF103_RUNTIME_H
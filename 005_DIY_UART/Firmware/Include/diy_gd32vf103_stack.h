@@ -0,0 +1,24 @@
+#ifndef DIY_GD32VF103_STACK_H
+#define DIY_GD32VF103_STACK_H
+
+#include "gd32vf103.h"
+
+/* pattern written over the whole .stack region by reset_handler (keep in sync with gd32vf103xb_boot.S) */
+#define DIY_STACK_PAINT_PATTERN       0xA5A5A5A5U
+/* words at the bottom of the stack that must stay painted */
+#define DIY_STACK_GUARD_WORDS         8U
+
+// stack region size in bytes (__stack_size in gd32vf103xb.ld)
+uint32_t diy_stack_size_get(void);
+// bytes in use right now
+uint32_t diy_stack_used_get(void);
+// deepest stack usage seen since reset, in bytes
+uint32_t diy_stack_peak_get(void);
+// check the guard words, ERROR once they have been overwritten (sticky), cheap enough for a timer tick
+ErrStatus diy_stack_guard_check(void);
+// diy_stack_guard_check() as a diy_systick hook
+void diy_stack_guard_tick(void);
+// last result of the guard check, without scanning
+ErrStatus diy_stack_guard_status_get(void);
+
+#endif //DIY_GD32VF103_STACK_H
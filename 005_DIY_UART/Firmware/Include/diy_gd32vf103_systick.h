@@ -0,0 +1,39 @@
+#ifndef DIY_GD32VF103_SYSTICK_H
+#define DIY_GD32VF103_SYSTICK_H
+
+#include "gd32vf103.h"
+
+/* core timer (mtime) definitions */
+#define SYSTIMER_BASE                 ((uint32_t)0xD1000000U)           /*!< core timer base address */
+
+/* core timer registers definitions */
+#define SYSTIMER_MTIME_LO             REG32(SYSTIMER_BASE + 0x00000000U)  /*!< timer counter, low word */
+#define SYSTIMER_MTIME_HI             REG32(SYSTIMER_BASE + 0x00000004U)  /*!< timer counter, high word */
+#define SYSTIMER_MTIMECMP_LO          REG32(SYSTIMER_BASE + 0x00000008U)  /*!< timer compare, low word */
+#define SYSTIMER_MTIMECMP_HI          REG32(SYSTIMER_BASE + 0x0000000CU)  /*!< timer compare, high word */
+#define SYSTIMER_MSFTRST              REG32(SYSTIMER_BASE + 0x00000FF0U)  /*!< software reset request */
+#define SYSTIMER_MSIP                 REG32(SYSTIMER_BASE + 0x00000FFCU)  /*!< software interrupt pending */
+
+/* constants definitions */
+#define SYSTIMER_CLOCK_DIV            4U                                /*!< mtime counts at CK_AHB / 4 */
+#define SYSTIMER_MSFTRST_KEY          0x80000A5FU                       /*!< value that triggers a system reset */
+
+#define DIY_SYSTICK_HOOKS_MAX         4U                                /*!< functions called on every tick */
+#define DIY_SYSTICK_IRQ_LEVEL         1U                                /*!< ECLIC level of the tick interrupt */
+
+typedef void (*diy_systick_hook_t)(void);
+
+// start the periodic tick (vectored eclic_mtip_handler), interrupts must be enabled globally
+void diy_systick_init(uint32_t tick_hz);
+// recompute the tick period from the current SystemCoreClock
+void diy_systick_reload(void);
+// run hook from the tick interrupt, ERROR when the table is full
+ErrStatus diy_systick_hook_add(diy_systick_hook_t hook);
+
+uint32_t diy_systick_get(void);
+uint32_t diy_systick_rate_get(void);
+void diy_systick_delay(uint32_t ticks);
+// clock change notifier (diy_clock_notifier_add), recomputes the tick period
+void diy_systick_clock_notify(uint32_t event, uint32_t hz);
+
+#endif //DIY_GD32VF103_SYSTICK_H
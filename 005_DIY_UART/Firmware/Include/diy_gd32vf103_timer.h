@@ -0,0 +1,34 @@
+#ifndef DIY_GD32VF103_TIMER_H
+#define DIY_GD32VF103_TIMER_H
+
+#include "gd32vf103.h"
+
+/* general level timers in use: TIMER1 paces the WS2812 stream, TIMER2 the logic capture,
+   TIMER4 channel 3 captures LXTAL for the IRC8M trim */
+#define TIMER1                        (TIMER_BASE + 0x00000000U)
+#define TIMER2                        (TIMER_BASE + 0x00000400U)
+#define TIMER4                        (TIMER_BASE + 0x00000C00U)
+
+/* TIMERx registers definitions */
+#define TIMER_CTL0(timerx)            REG32((timerx) + 0x00000000U)     /*!< control register 0 */
+#define TIMER_DMAINTEN(timerx)        REG32((timerx) + 0x0000000CU)     /*!< DMA and interrupt enable register */
+#define TIMER_INTF(timerx)            REG32((timerx) + 0x00000010U)     /*!< interrupt flag register */
+#define TIMER_SWEVG(timerx)           REG32((timerx) + 0x00000014U)     /*!< software event generation register */
+#define TIMER_CHCTL1(timerx)          REG32((timerx) + 0x0000001CU)     /*!< channel control register 1 */
+#define TIMER_CHCTL2(timerx)          REG32((timerx) + 0x00000020U)     /*!< channel control register 2 */
+#define TIMER_PSC(timerx)             REG32((timerx) + 0x00000028U)     /*!< prescaler register */
+#define TIMER_CAR(timerx)             REG32((timerx) + 0x0000002CU)     /*!< counter auto reload register */
+#define TIMER_CH3CV(timerx)           REG32((timerx) + 0x00000040U)     /*!< channel 3 capture/compare value register */
+
+/* TIMERx bits definitions */
+#define TIMER_CTL0_CEN                BIT(0)                            /*!< counter enable */
+#define TIMER_DMAINTEN_CH3IE          BIT(4)                            /*!< channel 3 capture/compare interrupt enable */
+#define TIMER_DMAINTEN_UPDEN          BIT(8)                            /*!< update DMA request enable */
+#define TIMER_INTF_CH3IF              BIT(4)                            /*!< channel 3 capture/compare flag */
+#define TIMER_INTF_CH3OF              BIT(12)                           /*!< channel 3 over capture flag */
+#define TIMER_SWEVG_UPG               BIT(0)                            /*!< update event generation */
+#define TIMER_CHCTL1_CH3MS_CI3        (1U << 8)                         /*!< channel 3 is an input, mapped on CI3 */
+#define TIMER_CHCTL1_CH3CAPPSC_DIV8   (3U << 10)                        /*!< capture every 8th edge */
+#define TIMER_CHCTL2_CH3EN            BIT(12)                           /*!< channel 3 capture enable */
+
+#endif //DIY_GD32VF103_TIMER_H
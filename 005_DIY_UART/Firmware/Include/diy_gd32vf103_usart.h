@@ -21,6 +21,18 @@
 #define USART_CTL2(usartx)            REG32((usartx) + (0x00000014U))   /*!< USART control register 2 */
 #define USART_GP(usartx)              REG32((usartx) + (0x00000018U))   /*!< USART guard time and prescaler register */
 
+/* USARTx_STAT */
+#define USART_STAT_PERR               BIT(0)                            /*!< parity error flag */
+#define USART_STAT_FERR               BIT(1)                            /*!< frame error flag */
+#define USART_STAT_NERR               BIT(2)                            /*!< noise error flag */
+#define USART_STAT_ORERR              BIT(3)                            /*!< overrun error */
+#define USART_STAT_IDLEF              BIT(4)                            /*!< IDLE frame detected flag */
+#define USART_STAT_RBNE               BIT(5)                            /*!< read data buffer not empty */
+#define USART_STAT_TC                 BIT(6)                            /*!< transmission complete */
+#define USART_STAT_TBE                BIT(7)                            /*!< transmit data buffer empty */
+#define USART_STAT_LBDF               BIT(8)                            /*!< LIN break detected flag */
+#define USART_STAT_CTSF               BIT(9)                            /*!< CTS change flag */
+
 /* USARTx_DATA */
 #define USART_DATA_DATA               BITS(0,8)                         /*!< transmit or read data value */
 
@@ -167,4 +179,8 @@ void diy_usart_send_byte(uint8_t data);
 void diy_usart_send_string(char* str);
 uint8_t diy_usart_receive_byte(void);
 uint8_t diy_usart_is_data_available(void);
+void diy_usart_send_dec(uint32_t value);
+void diy_usart_send_hex(uint32_t value);
+// clock change notifier (diy_clock_notifier_add), re-times USART0 to the stored baud rate
+void diy_usart_clock_notify(uint32_t event, uint32_t hz);
 #endif //DIY_GD32VF103_H
\ No newline at end of file
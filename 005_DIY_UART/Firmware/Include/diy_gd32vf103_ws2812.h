@@ -0,0 +1,39 @@
+#ifndef DIY_GD32VF103_WS2812_H
+#define DIY_GD32VF103_WS2812_H
+
+#include "gd32vf103.h"
+
+/* strip definitions */
+#define DIY_WS2812_DMA_CH             1U                                /*!< DMA0 channel 1 carries the TIMER1_UP request */
+#define DIY_WS2812_STREAM_WORDS       144U                              /*!< BOP words per half buffer, 6 bytes at 3 slots per bit */
+#define DIY_WS2812_SLOTS_MAX          6U                                /*!< most DMA writes per bit, the stream uses the fewest that fit */
+#define DIY_WS2812_TOLERANCE_NS       150U                              /*!< largest error of a streamed high time */
+#define DIY_WS2812_DMA_MIN_CYCLES     12U                               /*!< shortest slot (TIMER1 cycles) the DMA can keep up with */
+#define DIY_WS2812_MIN_T0H_CYCLES     12U                               /*!< shortest high time the bit-bang loop can place */
+#define DIY_WS2812_IRQ_LEVEL          2U                                /*!< ECLIC level of the DMA refill, above the tick */
+
+/* line timing of one protocol, in ns (us for the latch) */
+typedef struct {
+    uint16_t t0h_ns;      // high time of a 0 bit
+    uint16_t t1h_ns;      // high time of a 1 bit
+    uint16_t period_ns;   // bit period
+    uint16_t reset_us;    // low time that latches the frame
+}diy_ws2812_timing_t;
+
+#define DIY_WS2812_TIMING_WS2812B     {400U, 800U, 1250U, 280U}         /*!< WS2812B (newer parts latch after 280 us) */
+#define DIY_WS2812_TIMING_SK6812      {300U, 600U, 1250U, 80U}          /*!< SK6812 RGB and RGBW */
+#define DIY_WS2812_TIMING_WS2811      {500U, 1200U, 2500U, 50U}         /*!< WS2811 in low speed mode */
+
+// configure the data pin (push-pull output, driven low) and select the line timing, the port must be clocked
+void diy_ws2812_init(uint32_t gpio_periph, uint32_t pin, const diy_ws2812_timing_t *timing);
+// send len bytes (GRB order for WS2812) with interrupts masked, returns when the last bit is out
+// cycle deadlines come from SystemCoreClock, ERROR if the core clock is too slow or a stream is running
+ErrStatus diy_ws2812_send(const uint8_t *data, uint32_t len);
+// send len bytes through TIMER1 + DMA0 into GPIO_BOP, returns at once
+// data must stay valid until diy_ws2812_busy() returns RESET; the bit is cut in the fewest slots
+// (up to DIY_WS2812_SLOTS_MAX) that place t0h and t1h within DIY_WS2812_TOLERANCE_NS, ERROR if none do
+ErrStatus diy_ws2812_stream(const uint8_t *data, uint32_t len);
+// SET while a stream is running
+FlagStatus diy_ws2812_busy(void);
+
+#endif //DIY_GD32VF103_WS2812_H
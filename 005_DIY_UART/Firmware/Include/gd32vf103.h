@@ -35,7 +35,7 @@ OF SUCH DAMAGE.
 #ifndef GD32VF103_H
 #define GD32VF103_H
 
-#ifdef cplusplus
+#ifdef __cplusplus
  extern "C" {
 #endif 
 
@@ -176,7 +176,12 @@ typedef enum IRQn
 
 /* enum definitions */
 typedef enum {DISABLE = 0, ENABLE = !DISABLE} EventStatus, ControlStatus;
+#ifndef __cplusplus
 typedef enum {FALSE = 0, TRUE = !FALSE} bool;
+#else
+#define FALSE false
+#define TRUE  true
+#endif
 typedef enum {RESET = 0, SET = 1,MAX = 0X7FFFFFFF} FlagStatus;
 typedef enum {ERROR = 0, SUCCESS = !ERROR} ErrStatus;
 
@@ -188,6 +193,12 @@ typedef enum {ERROR = 0, SUCCESS = !ERROR} ErrStatus;
 #define BITS(start, end)             ((0xFFFFFFFFUL << (start)) & (0xFFFFFFFFUL >> (31U - (uint32_t)(end)))) 
 #define GET_BITS(regval, start, end) (((regval) & BITS((start),(end))) >> (start))
 
+/* code and data placement */
+/* place a function in the .ramfunc section, copied to SRAM by reset_handler */
+#define __RAMFUNC                    __attribute__((section(".ramfunc"), noinline))
+/* place a variable in .noinit, not cleared at reset */
+#define __NOINIT                     __attribute__((section(".noinit")))
+
 /* main flash and SRAM memory map */
 #define FLASH_BASE            ((uint32_t)0x08000000U)        /*!< main FLASH base address          */
 #define SRAM_BASE             ((uint32_t)0x20000000U)        /*!< SRAM0 base address               */
@@ -238,9 +249,31 @@ typedef enum {ERROR = 0, SUCCESS = !ERROR} ErrStatus;
 #include "gd32vf103_rcu.h"
 #include "gd32vf103_gpio.h"
 #include "system_gd32vf103.h"
+#include "diy_gd32vf103_csr.h"
 #include "diy_gd32vf103_usart.h"
-
-#ifdef cplusplus
+#include "diy_gd32vf103_bench.h"
+#include "diy_gd32vf103_heap.h"
+#include "diy_gd32vf103_stack.h"
+#include "diy_gd32vf103_eclic.h"
+#include "diy_gd32vf103_systick.h"
+#include "diy_gd32vf103_crc.h"
+#include "diy_gd32vf103_retain.h"
+#include "diy_gd32vf103_crash.h"
+#include "diy_gd32vf103_boottime.h"
+#include "diy_gd32vf103_runtime.h"
+#include "diy_gd32vf103_clock.h"
+#include "diy_gd32vf103_clkgate.h"
+#include "diy_gd32vf103_timer.h"
+#include "diy_gd32vf103_irctrim.h"
+#include "diy_gd32vf103_pin.h"
+#include "diy_gd32vf103_exti.h"
+#include "diy_gd32vf103_button.h"
+#include "diy_gd32vf103_ws2812.h"
+#include "diy_gd32vf103_board.h"
+#include "diy_gd32vf103_dma.h"
+#include "diy_gd32vf103_logic.h"
+
+#ifdef __cplusplus
 }
 #endif
 #endif 
\ No newline at end of file
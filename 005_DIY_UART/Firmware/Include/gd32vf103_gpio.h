@@ -263,6 +263,14 @@ OF SUCH DAMAGE.
 /* constants definitions */
 typedef FlagStatus bit_status;
 
+/* one gpio_init() call, for pin map tables passed to gpio_init_many() */
+typedef struct {
+    uint32_t gpio_periph;                                             /*!< GPIOx(x = A,B,C,D,E) */
+    uint32_t mode;                                                    /*!< GPIO_MODE_x */
+    uint32_t speed;                                                   /*!< GPIO_OSPEED_x, ignored for inputs */
+    uint32_t pin;                                                     /*!< GPIO_PIN_x, one or more */
+} gpio_init_parameter_struct;
+
 /* GPIO mode values set */
 #define GPIO_MODE_SET(n, mode)           ((uint32_t)((uint32_t)(mode) << (4U * (n))))
 #define GPIO_MODE_MASK(n)                (0xFU << (4U * (n)))
@@ -384,6 +392,8 @@ void gpio_deinit(uint32_t gpio_periph);
 void gpio_afio_deinit(void);
 /* GPIO parameter initialization */
 void gpio_init(uint32_t gpio_periph,uint32_t mode,uint32_t speed,uint32_t pin);
+/* GPIO parameter initialization from a table, each port's CTL0/CTL1 written once */
+void gpio_init_many(const gpio_init_parameter_struct *table, uint32_t count);
 
 /* set GPIO pin bit */
 void gpio_bit_set(uint32_t gpio_periph, uint32_t pin);
@@ -716,5 +716,11 @@ void rcu_deepsleep_voltage_set(uint32_t dsvol);
 
 /* get the system clock, bus and peripheral clock frequency */
 uint32_t rcu_clock_freq_get(rcu_clock_freq_enum clock);
+/* invalidate the cached clock frequencies after writing RCU_CFG0/RCU_CFG1 directly */
+void rcu_clock_cache_invalidate(void);
+/* decode CK_SYS/AHB/APB1/APB2 from RCU_CFG0/RCU_CFG1 values, shared by every frequency query */
+void rcu_clock_tree_decode(uint32_t cfg0, uint32_t cfg1, uint32_t freq[CK_APB2 + 1U]);
+/* PLL output for a PLL input and the PLLMF bits of RCU_CFG0 */
+uint32_t rcu_pll_output(uint32_t ck_src, uint32_t cfg0);
 
 #endif /* GD32VF103_RCU_H */
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include <stdint.h>
+#include "diy_gd32vf103_bench.h"
+
+/* mcycle value captured by the benchmark interrupt handlers */
+static volatile uint32_t bench_isr_cycle;
+
+// print "<name>: <total> cycles, <per loop> cycles/loop"
+static void bench_report(char* name, uint32_t cycles)
+{
+    diy_usart_send_string("  ");
+    diy_usart_send_string(name);
+    diy_usart_send_string(": ");
+    diy_usart_send_dec(cycles);
+    diy_usart_send_string(" cycles, ");
+    diy_usart_send_dec(cycles / DIY_BENCH_LOOPS);
+    diy_usart_send_string(" cycles/loop\r\n");
+}
+
+// raw BOP/BC toggle executed from flash
+static uint32_t bench_toggle_flash(uint32_t gpio_periph, uint32_t pin)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        GPIO_BOP(gpio_periph) = pin;
+        GPIO_BC(gpio_periph) = pin;
+    }
+
+    return diy_cycle_get() - start;
+}
+
+// same loop executed from SRAM
+// (mcycle is read inline: at -O0 diy_cycle_get() is a call into flash)
+__RAMFUNC static uint32_t bench_toggle_ram(uint32_t gpio_periph, uint32_t pin)
+{
+    uint32_t start = read_csr(CSR_MCYCLE);
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        GPIO_BOP(gpio_periph) = pin;
+        GPIO_BC(gpio_periph) = pin;
+    }
+
+    return read_csr(CSR_MCYCLE) - start;
+}
+
+// 001_Bare_Metal style: read-modify-write of OCTL at a constant address
+static uint32_t bench_toggle_octl_const(void)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        GPIO_OCTL(DIY_PIN_PORT(DIY_BENCH_PIN)) |= DIY_PIN_MASK(DIY_BENCH_PIN);
+        GPIO_OCTL(DIY_PIN_PORT(DIY_BENCH_PIN)) &= ~DIY_PIN_MASK(DIY_BENCH_PIN);
+    }
+
+    return diy_cycle_get() - start;
+}
+
+// pin descriptor macros, one BOP/BC store to a constant address each
+static uint32_t bench_toggle_pin_const(void)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        DIY_PIN_SET(DIY_BENCH_PIN);
+        DIY_PIN_RESET(DIY_BENCH_PIN);
+    }
+
+    return diy_cycle_get() - start;
+}
+
+// flash-resident copies of gpio_bit_set()/gpio_bit_reset() for comparison
+__attribute__((noinline))
+static void bench_bit_set_flash(uint32_t gpio_periph, uint32_t pin)
+{
+    GPIO_BOP(gpio_periph) = pin;
+}
+
+__attribute__((noinline))
+static void bench_bit_reset_flash(uint32_t gpio_periph, uint32_t pin)
+{
+    GPIO_BC(gpio_periph) = pin;
+}
+
+static uint32_t bench_call_flash(uint32_t gpio_periph, uint32_t pin)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        bench_bit_set_flash(gpio_periph, pin);
+        bench_bit_reset_flash(gpio_periph, pin);
+    }
+
+    return diy_cycle_get() - start;
+}
+
+// gpio_bit_set()/gpio_bit_reset() live in .ramfunc
+static uint32_t bench_call_ram(uint32_t gpio_periph, uint32_t pin)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        gpio_bit_set(gpio_periph, pin);
+        gpio_bit_reset(gpio_periph, pin);
+    }
+
+    return diy_cycle_get() - start;
+}
+
+// the former gpio_init(): one read-modify-write of CTL0/CTL1 per selected pin
+static void bench_gpio_init_per_pin(uint32_t gpio_periph, uint32_t mode, uint32_t speed, uint32_t pin)
+{
+    uint32_t temp_mode = mode & 0x0FU;
+
+    if (mode & 0x10U) {
+        temp_mode |= speed;
+    }
+    for (uint32_t i = 0U; i < 16U; i++) {
+        if ((1U << i) & pin) {
+            if (GPIO_MODE_IPD == mode) {
+                GPIO_BC(gpio_periph) = (1U << i);
+            } else if (GPIO_MODE_IPU == mode) {
+                GPIO_BOP(gpio_periph) = (1U << i);
+            }
+            if (i < 8U) {
+                GPIO_CTL0(gpio_periph) = (GPIO_CTL0(gpio_periph) & ~GPIO_MODE_MASK(i)) | GPIO_MODE_SET(i, temp_mode);
+            } else {
+                GPIO_CTL1(gpio_periph) = (GPIO_CTL1(gpio_periph) & ~GPIO_MODE_MASK(i - 8U)) | GPIO_MODE_SET(i - 8U, temp_mode);
+            }
+        }
+    }
+}
+
+static uint32_t bench_init_per_pin(const gpio_init_parameter_struct *table, uint32_t count)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        for (uint32_t j = 0U; j < count; j++) {
+            bench_gpio_init_per_pin(table[j].gpio_periph, table[j].mode, table[j].speed, table[j].pin);
+        }
+    }
+
+    return diy_cycle_get() - start;
+}
+
+static uint32_t bench_init_batched(const gpio_init_parameter_struct *table, uint32_t count)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        for (uint32_t j = 0U; j < count; j++) {
+            gpio_init(table[j].gpio_periph, table[j].mode, table[j].speed, table[j].pin);
+        }
+    }
+
+    return diy_cycle_get() - start;
+}
+
+static uint32_t bench_init_many(const gpio_init_parameter_struct *table, uint32_t count)
+{
+    uint32_t start = diy_cycle_get();
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        gpio_init_many(table, count);
+    }
+
+    return diy_cycle_get() - start;
+}
+
+// benchmark interrupt handlers, each only timestamps its entry
+__INTERRUPT void CAN1_TX_IRQHandler(void)
+{
+    bench_isr_cycle = read_csr(CSR_MCYCLE);
+}
+
+__RAMFUNC __INTERRUPT void CAN1_RX0_IRQHandler(void)
+{
+    bench_isr_cycle = read_csr(CSR_MCYCLE);
+}
+
+void CAN1_RX1_IRQHandler(void)
+{
+    bench_isr_cycle = read_csr(CSR_MCYCLE);
+}
+
+// cycles from setting the (edge triggered) pending bit to the first handler instruction
+static uint32_t bench_isr_entry(IRQn_Type irq, eclic_mode_enum mode)
+{
+    uint32_t start, total = 0U;
+
+    diy_eclic_mode_set(irq, mode);
+    diy_eclic_trigger_set(irq, ECLIC_TRIGGER_RISING);
+    diy_eclic_irq_enable(irq, 1U, 0U);
+
+    for (uint32_t i = 0; i < DIY_BENCH_LOOPS; i++) {
+        bench_isr_cycle = 0U;
+        start = read_csr(CSR_MCYCLE);
+        ECLIC_INT_IP(irq) = ECLIC_INT_IP_IP;
+        while (0U == bench_isr_cycle);
+        total += bench_isr_cycle - start;
+    }
+
+    diy_eclic_irq_disable(irq);
+    return total;
+}
+
+void diy_bench_run(void)
+{
+    uint32_t gpio_periph = DIY_PIN_PORT(DIY_BENCH_PIN);
+    uint32_t pin = DIY_PIN_MASK(DIY_BENCH_PIN);
+    uint32_t cycles;
+    bit_status octl = DIY_PIN_OUTPUT_GET(DIY_BENCH_PIN);
+
+    diy_usart_send_string("Benchmarks (");
+    diy_usart_send_dec(DIY_BENCH_LOOPS);
+    diy_usart_send_string(" loops @ ");
+    diy_usart_send_dec(SystemCoreClock);
+    diy_usart_send_string(" Hz):\r\n");
+
+    cycles = bench_toggle_flash(gpio_periph, pin);
+    bench_report("toggle loop, flash", cycles);
+    cycles = bench_toggle_ram(gpio_periph, pin);
+    bench_report("toggle loop, ram  ", cycles);
+
+    cycles = bench_toggle_octl_const();
+    bench_report("OCTL read-modify-write, const", cycles);
+    cycles = bench_toggle_pin_const();
+    bench_report("DIY_PIN_SET/RESET, const    ", cycles);
+
+    cycles = bench_call_flash(gpio_periph, pin);
+    bench_report("gpio_bit_set/reset, flash", cycles);
+    cycles = bench_call_ram(gpio_periph, pin);
+    bench_report("gpio_bit_set/reset, ram  ", cycles);
+
+    if (read_csr(mstatus) & MSTATUS_MIE) {
+        cycles = bench_isr_entry(DIY_BENCH_IRQ_FLASH, ECLIC_MODE_VECTORED);
+        bench_report("isr entry, vectored, flash", cycles);
+        cycles = bench_isr_entry(DIY_BENCH_IRQ_RAM, ECLIC_MODE_VECTORED);
+        bench_report("isr entry, vectored, ram  ", cycles);
+        cycles = bench_isr_entry(DIY_BENCH_IRQ_NON_VECTORED, ECLIC_MODE_NON_VECTORED);
+        bench_report("isr entry, non-vectored   ", cycles);
+    } else {
+        diy_usart_send_string("  isr entry: skipped, interrupts disabled\r\n");
+    }
+
+    // restore the pin state seen on entry
+    DIY_PIN_WRITE(DIY_BENCH_PIN, octl);
+}
+
+void diy_bench_gpio_init(const gpio_init_parameter_struct *table, uint32_t count)
+{
+    uint32_t cycles;
+
+    diy_usart_send_string("GPIO init benchmarks (");
+    diy_usart_send_dec(count);
+    diy_usart_send_string(" table entries):\r\n");
+
+    cycles = bench_init_per_pin(table, count);
+    bench_report("CTL RMW per pin      ", cycles);
+    cycles = bench_init_batched(table, count);
+    bench_report("gpio_init per entry  ", cycles);
+    cycles = bench_init_many(table, count);
+    bench_report("gpio_init_many       ", cycles);
+}
@@ -0,0 +1,114 @@
+#include <stdint.h>
+#include "diy_gd32vf103_board.h"
+
+#ifndef DIY_BOARD_PINS
+#error "no pin map for this board, add its rows to diy_gd32vf103_board.h"
+#endif
+
+/* every pin claims an enumerator named after it: a pin in two rows is a
+   "redeclaration of enumerator 'board_claim_Px_n'" */
+#define BOARD_CLAIM_(name, port, pin, mode, speed, level, clock)  board_claim_P##port##_##pin,
+#define BOARD_CLAIM(name)             DIY_BOARD_ROW(BOARD_CLAIM_, name)
+
+enum {
+    DIY_BOARD_PINS(BOARD_CLAIM)
+};
+
+/* an alternate function output is driven by its peripheral, which the row has to clock */
+#define BOARD_IS_AF(mode)             (((mode) == GPIO_MODE_AF_PP) || ((mode) == GPIO_MODE_AF_OD))
+#define BOARD_CHECK_(name, port, pin, mode, speed, level, clock) \
+    _Static_assert(!BOARD_IS_AF(mode) || ((clock) != DIY_BOARD_NO_CLOCK), \
+                   "board pin " #name " is an alternate function without a peripheral clock"); \
+    _Static_assert(((level) == 0) || ((level) == 1), "board pin " #name " level must be 0 or 1");
+#define BOARD_CHECK(name)             DIY_BOARD_ROW(BOARD_CHECK_, name)
+
+DIY_BOARD_PINS(BOARD_CHECK)
+
+/* the tables diy_board_init() works from, in row order */
+#define BOARD_INIT_(name, port, pin, mode, speed, level, clock) {GPIO##port, mode, speed, GPIO_PIN_##pin},
+#define BOARD_INIT(name)              DIY_BOARD_ROW(BOARD_INIT_, name)
+#define BOARD_LEVEL_(name, port, pin, mode, speed, level, clock) (level),
+#define BOARD_LEVEL(name)             DIY_BOARD_ROW(BOARD_LEVEL_, name)
+#define BOARD_CLOCK_(name, port, pin, mode, speed, level, clock) (clock),
+#define BOARD_CLOCK(name)             DIY_BOARD_ROW(BOARD_CLOCK_, name)
+#define BOARD_REMAP(remap)            (remap),
+
+static const gpio_init_parameter_struct board_pins[] = {
+    DIY_BOARD_PINS(BOARD_INIT)
+};
+static const uint8_t board_levels[] = {
+    DIY_BOARD_PINS(BOARD_LEVEL)
+};
+static const uint32_t board_clocks[] = {
+    DIY_BOARD_PINS(BOARD_CLOCK)
+};
+// zero terminated, the remap list may be empty
+static const uint32_t board_remaps[] = {
+    DIY_BOARD_REMAPS(BOARD_REMAP) 0U
+};
+
+#define BOARD_PIN_COUNT               (sizeof(board_pins) / sizeof(board_pins[0]))
+#define BOARD_PORT_COUNT              5U
+
+static const uint32_t board_ports[BOARD_PORT_COUNT] = {GPIOA, GPIOB, GPIOC, GPIOD, GPIOE};
+static const rcu_periph_enum board_port_clocks[BOARD_PORT_COUNT] = {
+    RCU_GPIOA, RCU_GPIOB, RCU_GPIOC, RCU_GPIOD, RCU_GPIOE
+};
+
+/* a peripheral shared by several rows is acquired once */
+static uint32_t board_clock_seen(uint32_t row)
+{
+    for (uint32_t i = 0U; i < row; i++) {
+        if (board_clocks[i] == board_clocks[row]) {
+            return 1U;
+        }
+    }
+    return 0U;
+}
+
+void diy_board_init(void)
+{
+    uint32_t bop[BOARD_PORT_COUNT] = {0U};
+    uint32_t used = 0U;
+
+    // port BOP words for the output levels, and the ports to clock
+    for (uint32_t i = 0U; i < BOARD_PIN_COUNT; i++) {
+        uint32_t port = (board_pins[i].gpio_periph - GPIOA) / (GPIOB - GPIOA);
+
+        used |= BIT(port);
+        if (board_pins[i].mode & GPIO_MODE_OUT_PP) {
+            bop[port] |= board_levels[i] ? board_pins[i].pin : (board_pins[i].pin << 16);
+        }
+    }
+
+    for (uint32_t port = 0U; port < BOARD_PORT_COUNT; port++) {
+        if (used & BIT(port)) {
+            diy_clkgate_acquire(board_port_clocks[port]);
+        }
+    }
+    for (uint32_t i = 0U; i < BOARD_PIN_COUNT; i++) {
+        if ((DIY_BOARD_NO_CLOCK != board_clocks[i]) && !board_clock_seen(i)) {
+            diy_clkgate_acquire((rcu_periph_enum)board_clocks[i]);
+        }
+    }
+    if (0U != board_remaps[0]) {
+        diy_clkgate_acquire(RCU_AF);
+        for (const uint32_t *remap = board_remaps; 0U != *remap; remap++) {
+            gpio_pin_remap_config(*remap, ENABLE);
+        }
+    }
+
+    // levels first, so an output starts at its level instead of the reset value of OCTL
+    for (uint32_t port = 0U; port < BOARD_PORT_COUNT; port++) {
+        if (0U != bop[port]) {
+            GPIO_BOP(board_ports[port]) = bop[port];
+        }
+    }
+    gpio_init_many(board_pins, BOARD_PIN_COUNT);
+}
+
+const gpio_init_parameter_struct *diy_board_pins_get(uint32_t *count)
+{
+    *count = BOARD_PIN_COUNT;
+    return board_pins;
+}
@@ -0,0 +1,39 @@
+#include <stdint.h>
+#include "diy_gd32vf103_boottime.h"
+
+/* written by reset_handler (reset, mem_init), main() (main_entry, clock_init)
+   and the fast-boot clock switch (clock_ready) */
+diy_boot_time_t diy_boot_time;
+
+static void boot_time_phase(char *name, uint32_t start, uint32_t end)
+{
+    uint32_t cycles = end - start;
+
+    diy_usart_send_string(name);
+    diy_usart_send_dec(cycles);
+    diy_usart_send_string(" cycles, ");
+    // everything up to the PLL switch runs from IRC8M
+    diy_usart_send_dec(cycles / DIY_BOOT_IRC8M_MHZ);
+    diy_usart_send_string(" us\r\n");
+}
+
+void diy_boot_time_report(void)
+{
+    diy_usart_send_string("Boot timing (mcycle at reset: ");
+    diy_usart_send_dec(diy_boot_time.reset);
+    diy_usart_send_string(")\r\n");
+    boot_time_phase((char *)"  memory init: ", diy_boot_time.reset, diy_boot_time.mem_init);
+    if (0U != diy_boot_time.constructors) {
+        // .init_array walk, part of the time to main
+        boot_time_phase((char *)"  C++ ctors:   ", diy_boot_time.mem_init, diy_boot_time.constructors);
+    } else {
+        diy_usart_send_string("  C++ ctors:   not run\r\n");
+    }
+    boot_time_phase((char *)"  to main:     ", diy_boot_time.mem_init, diy_boot_time.main_entry);
+    boot_time_phase((char *)"  SystemInit:  ", diy_boot_time.main_entry, diy_boot_time.clock_init);
+    boot_time_phase((char *)"  total:       ", diy_boot_time.reset, diy_boot_time.clock_init);
+    if (0U != diy_boot_time.clock_ready) {
+        // fast boot: SystemInit() returned on IRC8M, the PLL came up behind main()
+        boot_time_phase((char *)"  PLL switch:  ", diy_boot_time.main_entry, diy_boot_time.clock_ready);
+    }
+}
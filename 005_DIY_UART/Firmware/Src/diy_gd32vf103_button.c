@@ -0,0 +1,143 @@
+#include <stdint.h>
+#include "diy_gd32vf103_button.h"
+
+typedef struct {
+    uint32_t gpio_periph;
+    uint32_t line;
+    uint8_t active_high;
+    volatile uint8_t pressed;     // debounced state
+    volatile uint8_t settling;    // edge seen, line masked until the level has held
+    uint8_t long_sent;            // long press already reported for this press
+    uint32_t edge_tick;           // tick of the last edge
+    uint32_t press_tick;          // tick of the debounced press
+}button_state_t;
+
+static button_state_t button_table[DIY_BUTTON_MAX];
+static uint32_t button_count = 0U;
+
+/* single producer (systick) / single consumer (main loop) ring */
+static diy_button_event_t button_queue[DIY_BUTTON_QUEUE_SIZE];
+static volatile uint32_t button_queue_head = 0U;
+static volatile uint32_t button_queue_tail = 0U;
+
+static uint32_t button_ms_to_ticks(uint32_t ms)
+{
+    return (ms * diy_systick_rate_get() + 999U) / 1000U;
+}
+
+static uint8_t button_level_pressed(const button_state_t *button)
+{
+    uint8_t high = (GPIO_ISTAT(button->gpio_periph) & BIT(button->line)) ? 1U : 0U;
+
+    return (high == button->active_high) ? 1U : 0U;
+}
+
+static void button_queue_put(uint8_t id, diy_button_event_enum event)
+{
+    uint32_t head = button_queue_head;
+
+    // drop the event when the main loop is too far behind
+    if ((head - button_queue_tail) < DIY_BUTTON_QUEUE_SIZE) {
+        button_queue[head & (DIY_BUTTON_QUEUE_SIZE - 1U)].id = id;
+        button_queue[head & (DIY_BUTTON_QUEUE_SIZE - 1U)].event = event;
+        button_queue_head = head + 1U;
+    }
+}
+
+/* EXTI: first edge of a bounce burst, the rest is ignored until the tick samples the pin */
+static void button_edge(uint32_t line)
+{
+    for (uint32_t i = 0U; i < button_count; i++) {
+        if (button_table[i].line == line) {
+            diy_exti_disable(line);
+            button_table[i].edge_tick = diy_systick_get();
+            button_table[i].settling = 1U;
+        }
+    }
+}
+
+/* systick hook: sample settled buttons, time long presses */
+static void button_tick(void)
+{
+    uint32_t now = diy_systick_get();
+
+    for (uint32_t i = 0U; i < button_count; i++) {
+        button_state_t *button = &button_table[i];
+
+        if (button->settling && ((now - button->edge_tick) >= button_ms_to_ticks(DIY_BUTTON_DEBOUNCE_MS))) {
+            uint8_t pressed;
+
+            // unmask before sampling, an edge after this point is seen again
+            button->settling = 0U;
+            diy_exti_pending_clear(button->line);
+            diy_exti_enable(button->line);
+            pressed = button_level_pressed(button);
+
+            if (pressed != button->pressed) {
+                button->pressed = pressed;
+                button->press_tick = now;
+                button->long_sent = 0U;
+                button_queue_put((uint8_t)i, pressed ? DIY_BUTTON_EVENT_PRESS : DIY_BUTTON_EVENT_RELEASE);
+            }
+        }
+
+        if (button->pressed && !button->long_sent &&
+            ((now - button->press_tick) >= button_ms_to_ticks(DIY_BUTTON_LONG_MS))) {
+            button->long_sent = 1U;
+            button_queue_put((uint8_t)i, DIY_BUTTON_EVENT_LONG_PRESS);
+        }
+    }
+}
+
+int32_t diy_button_add(uint32_t gpio_periph, uint32_t line, uint8_t active_high)
+{
+    button_state_t *button;
+
+    if ((button_count >= DIY_BUTTON_MAX) || (line >= DIY_EXTI_GPIO_LINES)) {
+        return -1;
+    }
+    // one EXTI line per pin number, shared by all ports (PA0 and PB0 both use EXTI0)
+    for (uint32_t i = 0U; i < button_count; i++) {
+        if (button_table[i].line == line) {
+            return -1;
+        }
+    }
+
+    button = &button_table[button_count];
+    button->gpio_periph = gpio_periph;
+    button->line = line;
+    button->active_high = active_high ? 1U : 0U;
+    button->settling = 0U;
+    button->long_sent = 0U;
+    button->pressed = button_level_pressed(button);
+    button->press_tick = diy_systick_get();
+
+    if (SUCCESS != diy_exti_init(gpio_periph, line, DIY_EXTI_TRIG_BOTH, button_edge)) {
+        return -1;
+    }
+    if ((0U == button_count) && (SUCCESS != diy_systick_hook_add(button_tick))) {
+        diy_exti_disable(line);
+        return -1;
+    }
+    button_count++;
+
+    return (int32_t)(button_count - 1U);
+}
+
+diy_button_event_t diy_button_event_get(void)
+{
+    diy_button_event_t event = {0U, DIY_BUTTON_EVENT_NONE};
+    uint32_t tail = button_queue_tail;
+
+    if (tail != button_queue_head) {
+        event = button_queue[tail & (DIY_BUTTON_QUEUE_SIZE - 1U)];
+        button_queue_tail = tail + 1U;
+    }
+
+    return event;
+}
+
+FlagStatus diy_button_pressed(uint8_t id)
+{
+    return ((id < button_count) && button_table[id].pressed) ? SET : RESET;
+}
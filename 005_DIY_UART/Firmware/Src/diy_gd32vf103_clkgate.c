@@ -0,0 +1,112 @@
+#include <stdint.h>
+#include "diy_gd32vf103_clkgate.h"
+
+static diy_clkgate_entry_t clkgate_table[DIY_CLKGATE_MAX];
+static uint32_t clkgate_count = 0U;
+
+static diy_clkgate_entry_t *clkgate_find(rcu_periph_enum periph)
+{
+    for (uint32_t i = 0U; i < clkgate_count; i++) {
+        if (clkgate_table[i].periph == periph) {
+            return &clkgate_table[i];
+        }
+    }
+
+    return 0;
+}
+
+static uint32_t clkgate_ticks(const diy_clkgate_entry_t *entry)
+{
+    uint32_t ticks = entry->enabled_ticks;
+
+    if (0U != entry->refs) {
+        ticks += diy_systick_get() - entry->enabled_at;
+    }
+
+    return ticks;
+}
+
+ErrStatus diy_clkgate_acquire(rcu_periph_enum periph)
+{
+    ErrStatus status = ERROR;
+    uint32_t irq = diy_irq_save();
+    diy_clkgate_entry_t *entry = clkgate_find(periph);
+
+    if ((0 == entry) && (clkgate_count < DIY_CLKGATE_MAX)) {
+        entry = &clkgate_table[clkgate_count++];
+        entry->periph = periph;
+        entry->refs = 0U;
+        entry->enabled_ticks = 0U;
+    }
+
+    if (0 != entry) {
+        if (0U == entry->refs++) {
+            rcu_periph_clock_enable(periph);
+            entry->enabled_at = diy_systick_get();
+        }
+        status = SUCCESS;
+    }
+
+    diy_irq_restore(irq);
+    return status;
+}
+
+ErrStatus diy_clkgate_release(rcu_periph_enum periph)
+{
+    ErrStatus status = ERROR;
+    uint32_t irq = diy_irq_save();
+    diy_clkgate_entry_t *entry = clkgate_find(periph);
+
+    if ((0 != entry) && (0U != entry->refs)) {
+        if (0U == --entry->refs) {
+            // idle: stop the clock, the peripheral keeps its registers
+            rcu_periph_clock_disable(periph);
+            entry->enabled_ticks += diy_systick_get() - entry->enabled_at;
+        }
+        status = SUCCESS;
+    }
+
+    diy_irq_restore(irq);
+    return status;
+}
+
+uint32_t diy_clkgate_refs_get(rcu_periph_enum periph)
+{
+    diy_clkgate_entry_t *entry = clkgate_find(periph);
+
+    return (0 != entry) ? entry->refs : 0U;
+}
+
+uint32_t diy_clkgate_enabled_ticks_get(rcu_periph_enum periph)
+{
+    diy_clkgate_entry_t *entry = clkgate_find(periph);
+
+    return (0 != entry) ? clkgate_ticks(entry) : 0U;
+}
+
+void diy_clkgate_report(void)
+{
+    diy_usart_send_string("Peripheral clocks (tick ");
+    diy_usart_send_dec(diy_systick_get());
+    diy_usart_send_string("):\r\n");
+
+    for (uint32_t i = 0U; i < clkgate_count; i++) {
+        const diy_clkgate_entry_t *entry = &clkgate_table[i];
+        uint32_t reg = ((uint32_t)entry->periph >> 6);
+
+        // enable register and bit, as encoded by RCU_REGIDX_BIT()
+        if (AHBEN_REG_OFFSET == reg) {
+            diy_usart_send_string("  AHB  bit ");
+        } else if (APB2EN_REG_OFFSET == reg) {
+            diy_usart_send_string("  APB2 bit ");
+        } else {
+            diy_usart_send_string("  APB1 bit ");
+        }
+        diy_usart_send_dec(RCU_BIT_POS(entry->periph));
+        diy_usart_send_string(entry->refs ? ": on,  users " : ": off, users ");
+        diy_usart_send_dec(entry->refs);
+        diy_usart_send_string(", on for ");
+        diy_usart_send_dec(clkgate_ticks(entry));
+        diy_usart_send_string(" ticks\r\n");
+    }
+}
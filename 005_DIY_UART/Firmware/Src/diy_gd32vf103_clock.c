@@ -0,0 +1,552 @@
+#include <stdint.h>
+#include "diy_gd32vf103_clock.h"
+
+#define CLOCK_PREDV_MAX               16U
+
+/* PLLMF encodings, x2 to x32 (x15 does not exist, x6.5 does) */
+static const uint32_t clock_pllmf[] = {
+    RCU_PLL_MUL2,  RCU_PLL_MUL3,  RCU_PLL_MUL4,  RCU_PLL_MUL5,  RCU_PLL_MUL6,  RCU_PLL_MUL6_5,
+    RCU_PLL_MUL7,  RCU_PLL_MUL8,  RCU_PLL_MUL9,  RCU_PLL_MUL10, RCU_PLL_MUL11, RCU_PLL_MUL12,
+    RCU_PLL_MUL13, RCU_PLL_MUL14, RCU_PLL_MUL16, RCU_PLL_MUL17, RCU_PLL_MUL18, RCU_PLL_MUL19,
+    RCU_PLL_MUL20, RCU_PLL_MUL21, RCU_PLL_MUL22, RCU_PLL_MUL23, RCU_PLL_MUL24, RCU_PLL_MUL25,
+    RCU_PLL_MUL26, RCU_PLL_MUL27, RCU_PLL_MUL28, RCU_PLL_MUL29, RCU_PLL_MUL30, RCU_PLL_MUL31,
+    RCU_PLL_MUL32,
+};
+
+/* PLL1 multipliers and their CFG1 encoding */
+static const struct {
+    uint8_t mul;
+    uint32_t bits;
+} clock_pll1mf[] = {
+    { 8U, RCU_PLL1_MUL8},  { 9U, RCU_PLL1_MUL9},  {10U, RCU_PLL1_MUL10}, {11U, RCU_PLL1_MUL11},
+    {12U, RCU_PLL1_MUL12}, {13U, RCU_PLL1_MUL13}, {14U, RCU_PLL1_MUL14}, {15U, RCU_PLL1_MUL15},
+    {16U, RCU_PLL1_MUL16}, {20U, RCU_PLL1_MUL20},
+};
+
+#define CLOCK_TABLE_SIZE(table)       (sizeof(table) / sizeof((table)[0]))
+
+static diy_clock_notifier_t clock_notifiers[DIY_CLOCK_NOTIFIERS_MAX];
+static uint32_t clock_notifier_count = 0U;
+static diy_clock_status_t clock_status;
+
+/* fast boot: tree being brought up by RCU_CTC_IRQHandler */
+static diy_clock_config_t clock_async_config;
+static volatile uint32_t clock_async_pending = 0U;
+static uint32_t clock_async_ticks = 0U;
+
+/* set by the clock monitor NMI, the IRC8M tree is set up by clock_tick() */
+static volatile uint32_t clock_ckm_pending = 0U;
+
+static void clock_fault_log(uint32_t code)
+{
+    clock_status.last_code = code;
+    clock_status.last_tick = diy_systick_get();
+    diy_retain_log_add(code);
+}
+
+static void clock_fault_record(uint32_t *counter, uint32_t code)
+{
+    (*counter)++;
+    clock_fault_log(code);
+}
+
+/* count and log the stage at which diy_clock_config_apply() gave up */
+static void clock_apply_fault(diy_clock_apply_enum stage)
+{
+    switch (stage) {
+    case DIY_CLOCK_APPLY_HXTAL_FAIL:
+        clock_fault_record(&clock_status.hxtal_failures, DIY_CLOCK_LOG_HXTAL_FAIL);
+        break;
+    case DIY_CLOCK_APPLY_PLL_FAIL:
+        clock_fault_record(&clock_status.pll_failures, DIY_CLOCK_LOG_PLL_LOCK);
+        break;
+    case DIY_CLOCK_APPLY_IRC8M_FAIL:
+    case DIY_CLOCK_APPLY_SWITCH_FAIL:
+        clock_fault_record(&clock_status.switch_failures, DIY_CLOCK_LOG_SWITCH_FAIL);
+        break;
+    default:
+        break;
+    }
+}
+
+static void clock_notify(uint32_t event, uint32_t hz)
+{
+    for (uint32_t i = 0U; i < clock_notifier_count; i++) {
+        clock_notifiers[i](event, hz);
+    }
+}
+
+/* PLLMF bits that turn 'pll_in' into exactly 'target_hz', 0 if there are none */
+static uint32_t clock_pllmf_solve(uint32_t pll_in, uint32_t target_hz)
+{
+    if ((pll_in < DIY_CLOCK_PLL_IN_MIN) || (pll_in > DIY_CLOCK_PLL_IN_MAX)) {
+        return 0U;
+    }
+
+    for (uint32_t i = 0U; i < CLOCK_TABLE_SIZE(clock_pllmf); i++) {
+        // the RCU decode itself, so the result reads back unchanged
+        if (rcu_pll_output(pll_in, clock_pllmf[i]) == target_hz) {
+            // PLLSEL (HXTAL source) is set so that x2, encoded as 0, differs from "no solution"
+            return clock_pllmf[i] | RCU_CFG0_PLLSEL;
+        }
+    }
+
+    return 0U;
+}
+
+/* poll a stable flag of RCU_CTL, ERROR after 'timeout' reads */
+static ErrStatus clock_wait_stable(uint32_t flag, uint32_t timeout)
+{
+    uint32_t count = 0U;
+
+    while ((0U == (RCU_CTL & flag)) && (timeout != count)) {
+        count++;
+    }
+
+    return (RCU_CTL & flag) ? SUCCESS : ERROR;
+}
+
+static ErrStatus clock_hxtal_start(void)
+{
+    RCU_CTL |= RCU_CTL_HXTALEN;
+    return clock_wait_stable(RCU_CTL_HXTALSTB, HXTAL_STARTUP_TIMEOUT);
+}
+
+/* select CK_SYS, ERROR if SCSS does not follow within DIY_CLOCK_SWITCH_TIMEOUT reads */
+static ErrStatus clock_sys_switch(uint32_t scs)
+{
+    uint32_t count = 0U;
+
+    RCU_CFG0 = (RCU_CFG0 & ~RCU_CFG0_SCS) | scs;
+    while (((RCU_CFG0 & RCU_CFG0_SCSS) != (scs << 2)) && (DIY_CLOCK_SWITCH_TIMEOUT != count)) {
+        count++;
+    }
+
+    return ((RCU_CFG0 & RCU_CFG0_SCSS) == (scs << 2)) ? SUCCESS : ERROR;
+}
+
+ErrStatus diy_clock_solve(diy_clock_src_enum src, uint32_t target_hz, diy_clock_config_t *config)
+{
+    uint32_t bits;
+
+    config->hz = target_hz;
+    config->cfg0 = 0U;
+    config->cfg1 = 0U;
+
+    if ((DIY_CLOCK_SRC_IRC8M == src) && (IRC8M_VALUE == target_hz)) {
+        config->scs = RCU_CKSYSSRC_IRC8M;
+        return SUCCESS;
+    }
+    if ((DIY_CLOCK_SRC_HXTAL == src) && (HXTAL_VALUE == target_hz)) {
+        config->scs = RCU_CKSYSSRC_HXTAL;
+        return SUCCESS;
+    }
+    if (target_hz > DIY_CLOCK_SYS_MAX) {
+        return ERROR;
+    }
+
+    config->scs = RCU_CKSYSSRC_PLL;
+
+    if (DIY_CLOCK_SRC_IRC8M == src) {
+        bits = clock_pllmf_solve(IRC8M_VALUE / 2U, target_hz);
+        // PLLSEL clear: IRC8M/2
+        config->cfg0 = bits & ~RCU_CFG0_PLLSEL;
+        return (0U != bits) ? SUCCESS : ERROR;
+    }
+
+    // HXTAL -> PREDV0 -> PLL, largest PLL input first
+    for (uint32_t predv0 = 1U; predv0 <= CLOCK_PREDV_MAX; predv0++) {
+        if (0U != (HXTAL_VALUE % predv0)) {
+            continue;
+        }
+        bits = clock_pllmf_solve(HXTAL_VALUE / predv0, target_hz);
+        if (0U != bits) {
+            config->cfg0 = bits;
+            config->cfg1 = RCU_PREDV0SRC_HXTAL | CFG1_PREDV0(predv0 - 1U);
+            return SUCCESS;
+        }
+    }
+
+    // HXTAL -> PREDV1 -> PLL1 -> PREDV0 -> PLL, for crystals like 25 MHz
+    for (uint32_t predv1 = 1U; predv1 <= CLOCK_PREDV_MAX; predv1++) {
+        uint32_t pll1_in = HXTAL_VALUE / predv1;
+
+        if ((0U != (HXTAL_VALUE % predv1)) ||
+            (pll1_in < DIY_CLOCK_PLL1_IN_MIN) || (pll1_in > DIY_CLOCK_PLL1_IN_MAX)) {
+            continue;
+        }
+        for (uint32_t i = 0U; i < CLOCK_TABLE_SIZE(clock_pll1mf); i++) {
+            uint32_t pll1_out = pll1_in * clock_pll1mf[i].mul;
+
+            if ((pll1_out < DIY_CLOCK_PLL1_OUT_MIN) || (pll1_out > DIY_CLOCK_PLL1_OUT_MAX)) {
+                continue;
+            }
+            for (uint32_t predv0 = 1U; predv0 <= CLOCK_PREDV_MAX; predv0++) {
+                if (0U != (pll1_out % predv0)) {
+                    continue;
+                }
+                bits = clock_pllmf_solve(pll1_out / predv0, target_hz);
+                if (0U != bits) {
+                    config->cfg0 = bits;
+                    config->cfg1 = RCU_PREDV0SRC_CKPLL1 | CFG1_PREDV1(predv1 - 1U) |
+                                   clock_pll1mf[i].bits | CFG1_PREDV0(predv0 - 1U);
+                    return SUCCESS;
+                }
+            }
+        }
+    }
+
+    return ERROR;
+}
+
+/* the tree runs from HXTAL directly or through the PLL */
+static uint32_t clock_uses_hxtal(const diy_clock_config_t *config)
+{
+    return (RCU_CKSYSSRC_HXTAL == config->scs) ||
+           ((RCU_CKSYSSRC_PLL == config->scs) && (config->cfg0 & RCU_CFG0_PLLSEL));
+}
+
+static uint32_t clock_uses_pll1(const diy_clock_config_t *config)
+{
+    return (RCU_CKSYSSRC_PLL == config->scs) &&
+           (RCU_PREDV0SRC_CKPLL1 == (config->cfg1 & RCU_CFG1_PREDV0SEL));
+}
+
+static ErrStatus clock_pll_start(const diy_clock_config_t *config)
+{
+    if (clock_uses_pll1(config)) {
+        RCU_CTL |= RCU_CTL_PLL1EN;
+        if (SUCCESS != clock_wait_stable(RCU_CTL_PLL1STB, DIY_CLOCK_PLL_LOCK_TIMEOUT)) {
+            return ERROR;
+        }
+    }
+    RCU_CTL |= RCU_CTL_PLLEN;
+    return clock_wait_stable(RCU_CTL_PLLSTB, DIY_CLOCK_PLL_LOCK_TIMEOUT);
+}
+
+/* bus prescalers and PLL factors, the PLLs must be off */
+static void clock_tree_program(const diy_clock_config_t *config)
+{
+    // AHB = APB2 = CK_SYS, APB1 halved above 54 MHz
+    RCU_CFG0 &= ~(RCU_CFG0_AHBPSC | RCU_CFG0_APB1PSC | RCU_CFG0_APB2PSC);
+    RCU_CFG0 |= (RCU_AHB_CKSYS_DIV1 | RCU_APB2_CKAHB_DIV1);
+    RCU_CFG0 |= (config->hz > DIY_CLOCK_APB1_MAX) ? RCU_APB1_CKAHB_DIV2 : RCU_APB1_CKAHB_DIV1;
+
+    if (RCU_CKSYSSRC_PLL == config->scs) {
+        RCU_CFG0 &= ~(RCU_CFG0_PLLSEL | RCU_CFG0_PLLMF | RCU_CFG0_PLLMF_4);
+        RCU_CFG0 |= config->cfg0;
+        RCU_CFG1 &= ~(RCU_CFG1_PREDV0SEL | RCU_CFG1_PREDV1 | RCU_CFG1_PLL1MF | RCU_CFG1_PREDV0);
+        RCU_CFG1 |= config->cfg1;
+    }
+}
+
+/* final step once every oscillator of the tree is stable, called while CK_SYS is IRC8M */
+static diy_clock_apply_enum clock_tree_select(const diy_clock_config_t *config)
+{
+    if (SUCCESS != clock_sys_switch(config->scs)) {
+        // SCSS still reports IRC8M: point SCS back at it
+        clock_sys_switch(RCU_CKSYSSRC_IRC8M);
+        rcu_clock_cache_invalidate();
+        return DIY_CLOCK_APPLY_SWITCH_FAIL;
+    }
+
+    if (clock_uses_hxtal(config)) {
+        // a crystal that stops now raises the clock monitor NMI instead of stalling
+        rcu_hxtal_clock_monitor_enable();
+    } else {
+        // the crystal is not needed when running from IRC8M (low-power mode)
+        rcu_hxtal_clock_monitor_disable();
+        RCU_CTL &= ~RCU_CTL_HXTALEN;
+    }
+    rcu_clock_cache_invalidate();
+
+    return DIY_CLOCK_APPLY_DONE;
+}
+
+diy_clock_apply_enum diy_clock_config_apply(const diy_clock_config_t *config)
+{
+    diy_clock_apply_enum stage;
+    uint32_t irq;
+
+    // the oscillators start with interrupts enabled, only the switches are masked
+    if (clock_uses_hxtal(config) && (SUCCESS != clock_hxtal_start())) {
+        return DIY_CLOCK_APPLY_HXTAL_FAIL;
+    }
+
+    // run from IRC8M while the PLLs are reprogrammed
+    RCU_CTL |= RCU_CTL_IRC8MEN;
+    if (SUCCESS != clock_wait_stable(RCU_CTL_IRC8MSTB, IRC8M_STARTUP_TIMEOUT)) {
+        return DIY_CLOCK_APPLY_IRC8M_FAIL;
+    }
+
+    irq = diy_irq_save();
+    if (SUCCESS != clock_sys_switch(RCU_CKSYSSRC_IRC8M)) {
+        // still on the old tree, which may run from the PLLs: leave them alone
+        diy_irq_restore(irq);
+        return DIY_CLOCK_APPLY_SWITCH_FAIL;
+    }
+    RCU_CTL &= ~(RCU_CTL_PLLEN | RCU_CTL_PLL1EN);
+    clock_tree_program(config);
+    rcu_clock_cache_invalidate();
+    diy_irq_restore(irq);
+
+    if ((RCU_CKSYSSRC_PLL == config->scs) && (SUCCESS != clock_pll_start(config))) {
+        // left on IRC8M with the PLLs off
+        RCU_CTL &= ~(RCU_CTL_PLLEN | RCU_CTL_PLL1EN);
+        rcu_clock_cache_invalidate();
+        return DIY_CLOCK_APPLY_PLL_FAIL;
+    }
+
+    irq = diy_irq_save();
+    stage = clock_tree_select(config);
+    diy_irq_restore(irq);
+
+    return stage;
+}
+
+/* fastest configuration without the crystal: IRC8M/2 x27 = 108 MHz */
+static void clock_irc8m_fallback(void)
+{
+    diy_clock_config_t config;
+    diy_clock_apply_enum stage;
+
+    rcu_hxtal_clock_monitor_disable();
+    RCU_CTL &= ~RCU_CTL_HXTALEN;
+    if (SUCCESS == diy_clock_solve(DIY_CLOCK_SRC_IRC8M, DIY_CLOCK_SYS_MAX, &config)) {
+        stage = diy_clock_config_apply(&config);
+        clock_apply_fault(stage);
+    }
+}
+
+void diy_clock_fallback(const diy_clock_config_t *config, diy_clock_apply_enum stage)
+{
+    clock_apply_fault(stage);
+
+    if (clock_uses_hxtal(config)) {
+        // the crystal side failed or may have: the same speed class from IRC8M
+        clock_irc8m_fallback();
+    } else if (DIY_CLOCK_APPLY_PLL_FAIL == stage) {
+        // already on IRC8M and another IRC8M tree would not lock either (a fast-boot timeout
+        // leaves the PLL enabled)
+        RCU_CTL &= ~(RCU_CTL_PLLEN | RCU_CTL_PLL1EN);
+        rcu_clock_cache_invalidate();
+    }
+}
+
+ErrStatus diy_clock_ckm_handler(void)
+{
+    if (0U == (RCU_INT & RCU_INT_CKMIF)) {
+        return ERROR;
+    }
+
+    // hardware already moved CK_SYS to IRC8M and stopped the HXTAL based PLL; this is NMI
+    // context, which nothing can mask, so the rest waits for clock_tick()
+    RCU_INT |= RCU_INT_CKMIC;
+    clock_status.hxtal_stuck++;
+    clock_ckm_pending = 1U;
+
+    return SUCCESS;
+}
+
+/* clock monitor recovery, at tick level: back up to the fastest IRC8M tree */
+static void clock_ckm_recover(void)
+{
+    if (0U == clock_ckm_pending) {
+        return;
+    }
+    clock_ckm_pending = 0U;
+
+    clock_fault_log(DIY_CLOCK_LOG_HXTAL_STUCK);
+    clock_notify(DIY_CLOCK_EVENT_PRE, DIY_CLOCK_SYS_MAX);
+    clock_irc8m_fallback();
+    SystemCoreClockUpdate();
+    clock_notify(DIY_CLOCK_EVENT_POST, SystemCoreClock);
+}
+
+#define CLOCK_ASYNC_INT_EN            (RCU_INT_HXTALSTBIE | RCU_INT_PLLSTBIE | RCU_INT_PLL1STBIE)
+#define CLOCK_ASYNC_INT_CLR           (RCU_INT_HXTALSTBIC | RCU_INT_PLLSTBIC | RCU_INT_PLL1STBIC)
+
+static void clock_async_cancel(void)
+{
+    clock_async_pending = 0U;
+    RCU_INT = (RCU_INT & ~CLOCK_ASYNC_INT_EN) | CLOCK_ASYNC_INT_CLR;
+}
+
+/* advance HXTAL -> PLL1 -> PLL -> CK_SYS as far as the stable flags allow */
+static void clock_async_step(void)
+{
+    const diy_clock_config_t *config = &clock_async_config;
+
+    if (0U == clock_async_pending) {
+        return;
+    }
+    if (clock_uses_hxtal(config) && (0U == (RCU_CTL & RCU_CTL_HXTALSTB))) {
+        return;
+    }
+    if (clock_uses_pll1(config)) {
+        RCU_CTL |= RCU_CTL_PLL1EN;
+        if (0U == (RCU_CTL & RCU_CTL_PLL1STB)) {
+            return;
+        }
+    }
+    if (RCU_CKSYSSRC_PLL == config->scs) {
+        RCU_CTL |= RCU_CTL_PLLEN;
+        if (0U == (RCU_CTL & RCU_CTL_PLLSTB)) {
+            return;
+        }
+    }
+
+    // everything has locked, the rest of the boot so far ran from IRC8M
+    diy_boot_time.clock_ready = diy_cycle_get();
+    clock_async_cancel();
+
+    clock_notify(DIY_CLOCK_EVENT_PRE, config->hz);
+    clock_apply_fault(clock_tree_select(config));
+    SystemCoreClockUpdate();
+    clock_notify(DIY_CLOCK_EVENT_POST, SystemCoreClock);
+}
+
+/* gives up on the crystal after DIY_CLOCK_ASYNC_TIMEOUT_MS */
+static void clock_async_tick(void)
+{
+    if (0U == clock_async_pending) {
+        return;
+    }
+
+    clock_async_ticks++;
+    if ((clock_async_ticks * 1000U) < (DIY_CLOCK_ASYNC_TIMEOUT_MS * diy_systick_rate_get())) {
+        return;
+    }
+
+    clock_async_cancel();
+    clock_notify(DIY_CLOCK_EVENT_PRE, DIY_CLOCK_SYS_MAX);
+    diy_clock_fallback(&clock_async_config,
+                       (clock_uses_hxtal(&clock_async_config) && (0U == (RCU_CTL & RCU_CTL_HXTALSTB))) ?
+                       DIY_CLOCK_APPLY_HXTAL_FAIL : DIY_CLOCK_APPLY_PLL_FAIL);
+    SystemCoreClockUpdate();
+    diy_boot_time.clock_ready = diy_cycle_get();
+    clock_notify(DIY_CLOCK_EVENT_POST, SystemCoreClock);
+}
+
+ErrStatus diy_clock_async_start(const diy_clock_config_t *config)
+{
+    if (RCU_CKSYSSRC_IRC8M == config->scs) {
+        // already there
+        return SUCCESS;
+    }
+
+    clock_async_config = *config;
+    clock_async_ticks = 0U;
+
+    // PLLs are still off after reset, so the factors can be written up front
+    clock_tree_program(config);
+    RCU_INT = (RCU_INT & ~CLOCK_ASYNC_INT_EN) | CLOCK_ASYNC_INT_CLR;
+    RCU_INT |= CLOCK_ASYNC_INT_EN;
+    clock_async_pending = 1U;
+
+    if (clock_uses_hxtal(config)) {
+        RCU_CTL |= RCU_CTL_HXTALEN;
+    } else {
+        // IRC8M is already running, only the PLL has to lock
+        RCU_CTL |= RCU_CTL_PLLEN;
+    }
+
+    return SUCCESS;
+}
+
+/* systick hook */
+static void clock_tick(void)
+{
+    clock_ckm_recover();
+    clock_async_tick();
+}
+
+void diy_clock_irq_enable(void)
+{
+    diy_systick_hook_add(clock_tick);
+
+    if (0U == clock_async_pending) {
+        return;
+    }
+    // stable flags latched before this point raise the interrupt right away
+    diy_eclic_mode_set(RCU_CTC_IRQn, ECLIC_MODE_VECTORED);
+    diy_eclic_irq_enable(RCU_CTC_IRQn, DIY_CLOCK_ASYNC_IRQ_LEVEL, 0U);
+}
+
+FlagStatus diy_clock_async_pending(void)
+{
+    return (0U != clock_async_pending) ? SET : RESET;
+}
+
+__INTERRUPT void RCU_CTC_IRQHandler(void)
+{
+    // acknowledge whatever became stable, then see how far the tree can get
+    RCU_INT |= CLOCK_ASYNC_INT_CLR;
+    clock_async_step();
+}
+
+const diy_clock_status_t *diy_clock_status_get(void)
+{
+    return &clock_status;
+}
+
+ErrStatus diy_clock_notifier_add(diy_clock_notifier_t notifier)
+{
+    ErrStatus status = ERROR;
+    uint32_t irq = diy_irq_save();
+
+    if (clock_notifier_count < DIY_CLOCK_NOTIFIERS_MAX) {
+        clock_notifiers[clock_notifier_count++] = notifier;
+        status = SUCCESS;
+    }
+
+    diy_irq_restore(irq);
+    return status;
+}
+
+ErrStatus diy_clock_set(uint32_t target_hz)
+{
+    diy_clock_config_t config;
+    diy_clock_apply_enum stage;
+    // IRC8M itself needs neither the crystal nor the clock monitor
+    diy_clock_src_enum src = (IRC8M_VALUE == target_hz) ? DIY_CLOCK_SRC_IRC8M : DIY_CLOCK_SRC_HXTAL;
+
+    if ((SUCCESS != diy_clock_solve(src, target_hz, &config)) &&
+        (SUCCESS != diy_clock_solve(DIY_CLOCK_SRC_IRC8M, target_hz, &config))) {
+        return ERROR;
+    }
+
+    // an explicit request replaces a fast-boot switch still in progress
+    clock_async_cancel();
+
+    // let drivers drain (e.g. the USART shift register) on the old clock
+    clock_notify(DIY_CLOCK_EVENT_PRE, target_hz);
+
+    stage = diy_clock_config_apply(&config);
+    clock_apply_fault(stage);
+    if ((DIY_CLOCK_APPLY_DONE != stage) && clock_uses_hxtal(&config) &&
+        (SUCCESS == diy_clock_solve(DIY_CLOCK_SRC_IRC8M, target_hz, &config))) {
+        // the crystal side failed: try the same target from IRC8M
+        stage = diy_clock_config_apply(&config);
+        clock_apply_fault(stage);
+    }
+    SystemCoreClockUpdate();
+
+    clock_notify(DIY_CLOCK_EVENT_POST, SystemCoreClock);
+
+    return (DIY_CLOCK_APPLY_DONE == stage) ? SUCCESS : ERROR;
+}
+
+uint32_t diy_clock_get(void)
+{
+    return SystemCoreClock;
+}
+
+uint32_t diy_clock_timer_get(rcu_clock_freq_enum bus)
+{
+    uint32_t hz = rcu_clock_freq_get(bus);
+    uint32_t undivided = (CK_APB1 == bus) ? ((RCU_CFG0 & RCU_CFG0_APB1PSC) == RCU_APB1_CKAHB_DIV1)
+                                          : ((RCU_CFG0 & RCU_CFG0_APB2PSC) == RCU_APB2_CKAHB_DIV1);
+
+    return undivided ? hz : (hz * 2U);
+}
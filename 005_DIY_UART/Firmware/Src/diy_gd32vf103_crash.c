@@ -0,0 +1,110 @@
+#include <stdint.h>
+#include "diy_gd32vf103_crash.h"
+
+/* register file saved by trap_entry */
+uint32_t diy_crash_regs[32];
+
+/* survives the software reset, validated with magic + CRC */
+static __NOINIT diy_crash_record_t crash_record;
+
+static uint8_t crash_record_valid(void)
+{
+    return (SUCCESS == diy_retain_check(&crash_record.header, sizeof(crash_record), DIY_CRASH_MAGIC)) ? 1 : 0;
+}
+
+void diy_crash_handler(uint32_t *regs)
+{
+    uint32_t count = crash_record_valid() ? crash_record.count : 0U;
+
+    crash_record.version = DIY_CRASH_VERSION;
+    crash_record.count = count + 1U;
+    crash_record.tick = diy_systick_get();
+    crash_record.mcause = read_csr(mcause);
+    crash_record.mepc = read_csr(mepc);
+    crash_record.mtval = read_csr(mtval);
+    crash_record.mstatus = read_csr(mstatus);
+    crash_record.msubm = read_csr(CSR_MSUBM);
+    for (uint32_t i = 0U; i < 32U; i++) {
+        crash_record.regs[i] = regs[i];
+    }
+    diy_retain_commit(&crash_record.header, sizeof(crash_record), DIY_CRASH_MAGIC);
+    diy_retain_log_add(crash_record.mcause);
+
+    // reset the whole system, the record is reported on the next boot
+    diy_system_reset();
+}
+
+ErrStatus diy_nmi_handler(void)
+{
+    // recoverable NMI sources, anything else is reported as a crash
+    return diy_clock_ckm_handler();
+}
+
+char *diy_crash_cause_name(uint32_t mcause)
+{
+    if (mcause & MCAUSE_INTERRUPT) {
+        return (char *)"unhandled interrupt";
+    }
+
+    switch (mcause & MCAUSE_EXCCODE) {
+    case 0:
+        return (char *)"instruction address misaligned";
+    case 1:
+        return (char *)"instruction access fault";
+    case 2:
+        return (char *)"illegal instruction";
+    case 3:
+        return (char *)"breakpoint";
+    case 4:
+        return (char *)"load address misaligned";
+    case 5:
+        return (char *)"load access fault";
+    case 6:
+        return (char *)"store address misaligned";
+    case 7:
+        return (char *)"store access fault";
+    case 11:
+        return (char *)"environment call";
+    case MCAUSE_EXCCODE_NMI:
+        return (char *)"NMI";
+    default:
+        return (char *)"unknown";
+    }
+}
+
+ErrStatus diy_crash_report(void)
+{
+    uint8_t *raw = (uint8_t *)&crash_record;
+
+    if (!crash_record_valid()) {
+        return ERROR;
+    }
+
+    // binary record first, tools sync on the magic
+    for (uint32_t i = 0U; i < sizeof(diy_crash_record_t); i++) {
+        diy_usart_send_byte(raw[i]);
+    }
+
+    diy_usart_send_string("\r\nCrash #");
+    diy_usart_send_dec(crash_record.count);
+    diy_usart_send_string(": ");
+    diy_usart_send_string(diy_crash_cause_name(crash_record.mcause));
+    if (crash_record.mcause & MCAUSE_INTERRUPT) {
+        diy_usart_send_string(" ");
+        diy_usart_send_dec(crash_record.mcause & MCAUSE_EXCCODE);
+    }
+    diy_usart_send_string(", mepc=");
+    diy_usart_send_hex(crash_record.mepc);
+    diy_usart_send_string(", mtval=");
+    diy_usart_send_hex(crash_record.mtval);
+    diy_usart_send_string(", ra=");
+    diy_usart_send_hex(crash_record.regs[1]);
+    diy_usart_send_string(", sp=");
+    diy_usart_send_hex(crash_record.regs[2]);
+    diy_usart_send_string("\r\n");
+
+    // reported once
+    diy_retain_invalidate(&crash_record.header);
+
+    return SUCCESS;
+}
@@ -0,0 +1,21 @@
+#include <stdint.h>
+#include "diy_gd32vf103_crc.h"
+
+uint32_t diy_crc32_calc(const uint32_t *data, uint32_t words)
+{
+    uint32_t crc;
+    uint32_t irq = diy_irq_save();
+
+    // the unit is shared, so the whole block is computed in one go
+    // and its clock only runs while it does
+    diy_clkgate_acquire(RCU_CRC);
+    CRC_CTL = CRC_CTL_RST;
+    while (words--) {
+        CRC_DATA = *data++;
+    }
+    crc = CRC_DATA;
+    diy_clkgate_release(RCU_CRC);
+
+    diy_irq_restore(irq);
+    return crc;
+}
@@ -0,0 +1,18 @@
+#include <stdint.h>
+#include "gd32vf103.h"
+
+/* C++ static objects: the constructor below is not constexpr, so the compiler emits it
+   into .init_array and it only runs if diy_runtime_init() walks that table at boot */
+namespace {
+
+class boot_stamp {
+public:
+    boot_stamp()
+    {
+        diy_boot_time.constructors = diy_cycle_get();
+    }
+};
+
+boot_stamp cxx_boot_stamp;
+
+}
@@ -0,0 +1,103 @@
+#include <stdint.h>
+#include "diy_gd32vf103_eclic.h"
+
+// number of level bits currently selected in ECLIC_CFG
+static uint32_t eclic_nlbits_get(void)
+{
+    uint32_t nlbits = GET_BITS(ECLIC_CFG, 1U, 4U);
+
+    return (nlbits > ECLIC_CTLBITS) ? ECLIC_CTLBITS : nlbits;
+}
+
+void diy_eclic_init(void)
+{
+    ECLIC_CFG = 0U;
+    ECLIC_MTH = 0U;
+
+    for (uint32_t irq = 0U; irq < ECLIC_NUM_INTERRUPTS; irq++) {
+        ECLIC_INT_IE(irq) = 0U;
+        ECLIC_INT_IP(irq) = 0U;
+        ECLIC_INT_ATTR(irq) = 0U;
+        ECLIC_INT_CTL(irq) = 0U;
+    }
+}
+
+void diy_eclic_priority_group_set(uint32_t prigroup)
+{
+    ECLIC_CFG = (uint8_t)((ECLIC_CFG & ~ECLIC_CFG_NLBITS) | (prigroup & ECLIC_CFG_NLBITS));
+}
+
+void diy_eclic_threshold_set(uint8_t level)
+{
+    uint32_t nlbits = eclic_nlbits_get();
+
+    /* sources whose level is below 'level' are masked, level 0 masks nothing */
+    if (0U == nlbits) {
+        ECLIC_MTH = 0U;
+    } else {
+        ECLIC_MTH = (uint8_t)(level << (8U - nlbits));
+    }
+}
+
+void diy_eclic_level_priority_set(IRQn_Type irq, uint8_t level, uint8_t priority)
+{
+    uint32_t nlbits = eclic_nlbits_get();
+    uint32_t ctl;
+
+    level &= (uint8_t)((1U << nlbits) - 1U);
+    priority &= (uint8_t)((1U << (ECLIC_CTLBITS - nlbits)) - 1U);
+
+    /* level in the upper nlbits, priority below it, unimplemented bits read as 1 */
+    ctl = ((uint32_t)level << (ECLIC_CTLBITS - nlbits)) | priority;
+    ECLIC_INT_CTL(irq) = (uint8_t)((ctl << (8U - ECLIC_CTLBITS)) | (0xFFU >> ECLIC_CTLBITS));
+}
+
+void diy_eclic_irq_enable(IRQn_Type irq, uint8_t level, uint8_t priority)
+{
+    diy_eclic_level_priority_set(irq, level, priority);
+    ECLIC_INT_IE(irq) |= ECLIC_INT_IE_IE;
+}
+
+void diy_eclic_irq_disable(IRQn_Type irq)
+{
+    ECLIC_INT_IE(irq) &= ~ECLIC_INT_IE_IE;
+}
+
+void diy_eclic_mode_set(IRQn_Type irq, eclic_mode_enum mode)
+{
+    if (ECLIC_MODE_VECTORED == mode) {
+        ECLIC_INT_ATTR(irq) |= ECLIC_INT_ATTR_SHV;
+    } else {
+        ECLIC_INT_ATTR(irq) &= ~ECLIC_INT_ATTR_SHV;
+    }
+}
+
+void diy_eclic_trigger_set(IRQn_Type irq, uint32_t trigger)
+{
+    uint8_t attr;
+
+    attr = ECLIC_INT_ATTR(irq);
+    attr &= ~ECLIC_INT_ATTR_TRIG;
+    attr |= (uint8_t)(trigger & ECLIC_INT_ATTR_TRIG);
+    ECLIC_INT_ATTR(irq) = attr;
+}
+
+void diy_eclic_pending_set(IRQn_Type irq)
+{
+    ECLIC_INT_IP(irq) |= ECLIC_INT_IP_IP;
+}
+
+void diy_eclic_pending_clear(IRQn_Type irq)
+{
+    ECLIC_INT_IP(irq) &= ~ECLIC_INT_IP_IP;
+}
+
+void diy_eclic_global_interrupt_enable(void)
+{
+    set_csr(mstatus, MSTATUS_MIE);
+}
+
+void diy_eclic_global_interrupt_disable(void)
+{
+    clear_csr(mstatus, MSTATUS_MIE);
+}
@@ -0,0 +1,122 @@
+#include <stdint.h>
+#include "diy_gd32vf103_exti.h"
+
+static diy_exti_handler_t exti_handlers[DIY_EXTI_GPIO_LINES];
+
+/* ECLIC source shared by a line */
+static IRQn_Type exti_irq(uint32_t line)
+{
+    if (line < 5U) {
+        return (IRQn_Type)(EXTI0_IRQn + line);
+    }
+
+    return (line < 10U) ? EXTI5_9_IRQn : EXTI10_15_IRQn;
+}
+
+/* run the handlers of the pending, enabled lines in [first, last] */
+static void exti_dispatch(uint32_t first, uint32_t last)
+{
+    uint32_t pending = EXTI_PD & EXTI_INTEN;
+
+    for (uint32_t line = first; line <= last; line++) {
+        if (pending & BIT(line)) {
+            EXTI_PD = BIT(line);
+            if (0 != exti_handlers[line]) {
+                exti_handlers[line](line);
+            }
+        }
+    }
+}
+
+ErrStatus diy_exti_init(uint32_t gpio_periph, uint32_t line, diy_exti_trig_enum trig, diy_exti_handler_t handler)
+{
+    if (line >= DIY_EXTI_GPIO_LINES) {
+        return ERROR;
+    }
+
+    // AFIO owns the port selection of each line, GPIOA..E are 0x400 apart
+    diy_clkgate_acquire(RCU_AF);
+    gpio_exti_source_select((uint8_t)((gpio_periph - GPIOA) / (GPIOB - GPIOA)), (uint8_t)line);
+
+    exti_handlers[line] = handler;
+    EXTI_INTEN &= ~BIT(line);
+    EXTI_EVEN &= ~BIT(line);
+    if (trig & DIY_EXTI_TRIG_RISING) {
+        EXTI_RTEN |= BIT(line);
+    } else {
+        EXTI_RTEN &= ~BIT(line);
+    }
+    if (trig & DIY_EXTI_TRIG_FALLING) {
+        EXTI_FTEN |= BIT(line);
+    } else {
+        EXTI_FTEN &= ~BIT(line);
+    }
+    EXTI_PD = BIT(line);
+    EXTI_INTEN |= BIT(line);
+
+    diy_eclic_mode_set(exti_irq(line), ECLIC_MODE_VECTORED);
+    diy_eclic_irq_enable(exti_irq(line), DIY_EXTI_IRQ_LEVEL, 0U);
+
+    return SUCCESS;
+}
+
+void diy_exti_enable(uint32_t line)
+{
+    uint32_t irq = diy_irq_save();
+
+    EXTI_INTEN |= BIT(line);
+    diy_irq_restore(irq);
+}
+
+void diy_exti_disable(uint32_t line)
+{
+    uint32_t irq = diy_irq_save();
+
+    EXTI_INTEN &= ~BIT(line);
+    diy_irq_restore(irq);
+}
+
+FlagStatus diy_exti_pending_get(uint32_t line)
+{
+    return (EXTI_PD & BIT(line)) ? SET : RESET;
+}
+
+void diy_exti_pending_clear(uint32_t line)
+{
+    EXTI_PD = BIT(line);
+}
+
+__INTERRUPT void EXTI0_IRQHandler(void)
+{
+    exti_dispatch(0U, 0U);
+}
+
+__INTERRUPT void EXTI1_IRQHandler(void)
+{
+    exti_dispatch(1U, 1U);
+}
+
+__INTERRUPT void EXTI2_IRQHandler(void)
+{
+    exti_dispatch(2U, 2U);
+}
+
+__INTERRUPT void EXTI3_IRQHandler(void)
+{
+    exti_dispatch(3U, 3U);
+}
+
+__INTERRUPT void EXTI4_IRQHandler(void)
+{
+    exti_dispatch(4U, 4U);
+}
+
+__INTERRUPT void EXTI5_9_IRQHandler(void)
+{
+    exti_dispatch(5U, 9U);
+}
+
+__INTERRUPT void EXTI10_15_IRQHandler(void)
+{
+    exti_dispatch(10U, 15U);
+}
@@ -0,0 +1,184 @@
+#include <stdint.h>
+#include "diy_gd32vf103_heap.h"
+
+/* provided by gd32vf103xb.ld */
+extern uint8_t _end[];
+extern uint8_t _heap_end[];
+
+/* next free byte of the heap region, 0 until first use */
+static uint8_t *heap_next = 0;
+
+void *diy_heap_reserve(uint32_t size)
+{
+    uint8_t *block = 0;
+    uint32_t irq = diy_irq_save();
+
+    if (0 == heap_next) {
+        heap_next = (uint8_t *)DIY_HEAP_ALIGN_UP(_end);
+    }
+
+    size = DIY_HEAP_ALIGN_UP(size);
+    if (size <= (uint32_t)(_heap_end - heap_next)) {
+        block = heap_next;
+        heap_next += size;
+    }
+
+    diy_irq_restore(irq);
+    return block;
+}
+
+uint32_t diy_heap_size_get(void)
+{
+    return (uint32_t)(_heap_end - (uint8_t *)DIY_HEAP_ALIGN_UP(_end));
+}
+
+uint32_t diy_heap_free_get(void)
+{
+    uint8_t *next = heap_next ? heap_next : (uint8_t *)DIY_HEAP_ALIGN_UP(_end);
+
+    return (uint32_t)(_heap_end - next);
+}
+
+ErrStatus diy_pool_init(diy_pool_t *pool, uint32_t block_size, uint32_t block_count)
+{
+    uint8_t *block;
+
+    block_size = DIY_HEAP_ALIGN_UP(block_size);
+    if ((0U == block_size) || (0U == block_count) ||
+        (block_size > 0xFFFFU) || (block_count > 0xFFFFU)) {
+        return ERROR;
+    }
+
+    // blocks and allocation bitmap in one reservation, so a failure leaves the heap untouched
+    pool->storage = diy_heap_reserve(block_size * block_count +
+                                     ((block_count + 31U) / 32U) * sizeof(uint32_t));
+    if (0 == pool->storage) {
+        return ERROR;
+    }
+    pool->allocated = (uint32_t *)(pool->storage + block_size * block_count);
+    for (uint32_t i = 0U; i < (block_count + 31U) / 32U; i++) {
+        pool->allocated[i] = 0U;
+    }
+
+    pool->block_size = (uint16_t)block_size;
+    pool->block_count = (uint16_t)block_count;
+    pool->used = 0U;
+    pool->peak = 0U;
+    pool->fail_count = 0U;
+    pool->bad_frees = 0U;
+
+    // thread every block onto the free list
+    pool->free_list = 0;
+    block = pool->storage + block_size * block_count;
+    while (block != pool->storage) {
+        block -= block_size;
+        *(void **)block = pool->free_list;
+        pool->free_list = block;
+    }
+
+    return SUCCESS;
+}
+
+void *diy_pool_alloc(diy_pool_t *pool)
+{
+    void *block;
+    uint32_t irq = diy_irq_save();
+
+    block = pool->free_list;
+    if (block) {
+        uint32_t index = (uint32_t)((uint8_t *)block - pool->storage) / pool->block_size;
+
+        pool->free_list = *(void **)block;
+        pool->allocated[index / 32U] |= BIT(index % 32U);
+        pool->used++;
+        if (pool->used > pool->peak) {
+            pool->peak = pool->used;
+        }
+    } else {
+        pool->fail_count++;
+    }
+
+    diy_irq_restore(irq);
+    return block;
+}
+
+ErrStatus diy_pool_free(diy_pool_t *pool, void *block)
+{
+    uint32_t offset = (uint32_t)((uint8_t *)block - pool->storage);
+    uint32_t index = offset / pool->block_size;
+    ErrStatus status = ERROR;
+    uint32_t irq;
+
+    if (0 == block) {
+        return SUCCESS;
+    }
+
+    irq = diy_irq_save();
+    // inside the storage (offset wraps for pointers below it), on a block start, handed out
+    if ((index < pool->block_count) && (0U == (offset % pool->block_size)) &&
+        (pool->allocated[index / 32U] & BIT(index % 32U))) {
+        pool->allocated[index / 32U] &= ~BIT(index % 32U);
+        *(void **)block = pool->free_list;
+        pool->free_list = block;
+        pool->used--;
+        status = SUCCESS;
+    } else {
+        pool->bad_frees++;
+    }
+    diy_irq_restore(irq);
+
+    return status;
+}
+
+ErrStatus diy_arena_init(diy_arena_t *arena, uint32_t size)
+{
+    size = DIY_HEAP_ALIGN_UP(size);
+    arena->base = diy_heap_reserve(size);
+    if (0 == arena->base) {
+        return ERROR;
+    }
+
+    arena->size = size;
+    arena->offset = 0U;
+    arena->peak = 0U;
+    arena->fail_count = 0U;
+
+    return SUCCESS;
+}
+
+void *diy_arena_alloc(diy_arena_t *arena, uint32_t size)
+{
+    void *block = 0;
+    uint32_t irq = diy_irq_save();
+
+    size = DIY_HEAP_ALIGN_UP(size);
+    if (size <= (arena->size - arena->offset)) {
+        block = arena->base + arena->offset;
+        arena->offset += size;
+        if (arena->offset > arena->peak) {
+            arena->peak = arena->offset;
+        }
+    } else {
+        arena->fail_count++;
+    }
+
+    diy_irq_restore(irq);
+    return block;
+}
+
+uint32_t diy_arena_mark(diy_arena_t *arena)
+{
+    return arena->offset;
+}
+
+void diy_arena_reset(diy_arena_t *arena, uint32_t mark)
+{
+    uint32_t irq = diy_irq_save();
+
+    // only ever roll back, a stale mark must not grow the arena
+    if (mark < arena->offset) {
+        arena->offset = mark;
+    }
+
+    diy_irq_restore(irq);
+}
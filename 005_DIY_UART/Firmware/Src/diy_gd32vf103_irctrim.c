@@ -0,0 +1,120 @@
+#include <stdint.h>
+#include "diy_gd32vf103_irctrim.h"
+
+static diy_irctrim_status_t irctrim_status;
+static uint32_t irctrim_captures = 0U;
+static uint32_t irctrim_sum = 0U;
+static uint16_t irctrim_last = 0U;
+
+/* the timer only measures IRC8M when CK_SYS is derived from it */
+static uint32_t irctrim_from_irc8m(void)
+{
+    uint32_t scss = RCU_CFG0 & RCU_CFG0_SCSS;
+
+    return (RCU_SCSS_IRC8M == scss) ||
+           ((RCU_SCSS_PLL == scss) && (0U == (RCU_CFG0 & RCU_CFG0_PLLSEL)));
+}
+
+static void irctrim_restart(void)
+{
+    irctrim_captures = 0U;
+    irctrim_sum = 0U;
+}
+
+/* compare one window of timer counts with what an exact IRC8M would give */
+static void irctrim_window_done(uint32_t counts)
+{
+    uint64_t expected;
+    int32_t error_ppm;
+
+    if (!irctrim_from_irc8m()) {
+        return;
+    }
+
+    expected = ((uint64_t)diy_clock_timer_get(CK_APB1) * DIY_IRCTRIM_WINDOW * DIY_IRCTRIM_CAPTURE_DIV) / LXTAL_VALUE;
+    error_ppm = (int32_t)((((int64_t)counts - (int64_t)expected) * 1000000) / (int64_t)expected);
+
+    irctrim_status.windows++;
+    irctrim_status.error_ppm = error_ppm;
+
+    // one step is coarse, so only move when it brings the error closer to 0
+    if ((error_ppm > (DIY_IRCTRIM_STEP_PPM / 2)) && (irctrim_status.trim > 0U)) {
+        irctrim_status.trim--;
+    } else if ((error_ppm < -(DIY_IRCTRIM_STEP_PPM / 2)) && (irctrim_status.trim < DIY_IRCTRIM_ADJ_MAX)) {
+        irctrim_status.trim++;
+    } else {
+        return;
+    }
+    rcu_irc8m_adjust_value_set(irctrim_status.trim);
+    irctrim_status.adjustments++;
+}
+
+void diy_irctrim_init(void)
+{
+    irctrim_status.trim = (RCU_CTL & RCU_CTL_IRC8MADJ) >> 3;
+    irctrim_restart();
+
+    // LXTAL lives in the backup domain, write access needs PMU and BKPI clocked
+    diy_clkgate_acquire(RCU_PMU);
+    diy_clkgate_acquire(RCU_BKPI);
+    PMU_CTL |= PMU_CTL_BKPWEN;
+    RCU_BDCTL |= RCU_BDCTL_LXTALEN;
+    PMU_CTL &= ~PMU_CTL_BKPWEN;
+    diy_clkgate_release(RCU_BKPI);
+    diy_clkgate_release(RCU_PMU);
+
+    // LXTAL -> TIMER4_CH3 instead of PA3
+    diy_clkgate_acquire(RCU_AF);
+    AFIO_PCF0 |= AFIO_PCF0_TIMER4CH3_IREMAP;
+
+    // free running 16-bit counter, capture every 8th LXTAL edge
+    diy_clkgate_acquire(RCU_TIMER4);
+    TIMER_CTL0(TIMER4) = 0U;
+    TIMER_PSC(TIMER4) = 0U;
+    TIMER_CAR(TIMER4) = 0xFFFFU;
+    TIMER_CHCTL1(TIMER4) = TIMER_CHCTL1_CH3MS_CI3 | TIMER_CHCTL1_CH3CAPPSC_DIV8;
+    TIMER_CHCTL2(TIMER4) = TIMER_CHCTL2_CH3EN;
+    TIMER_INTF(TIMER4) = 0U;
+    TIMER_DMAINTEN(TIMER4) = TIMER_DMAINTEN_CH3IE;
+    TIMER_CTL0(TIMER4) = TIMER_CTL0_CEN;
+
+    diy_eclic_mode_set(TIMER4_IRQn, ECLIC_MODE_VECTORED);
+    diy_eclic_irq_enable(TIMER4_IRQn, DIY_IRCTRIM_IRQ_LEVEL, 0U);
+}
+
+void diy_irctrim_clock_notify(uint32_t event, uint32_t hz)
+{
+    // counts from before and after a switch do not belong to the same clock
+    irctrim_restart();
+}
+
+FlagStatus diy_irctrim_lxtal_ready(void)
+{
+    return (RCU_BDCTL & RCU_BDCTL_LXTALSTB) ? SET : RESET;
+}
+
+const diy_irctrim_status_t *diy_irctrim_status_get(void)
+{
+    return &irctrim_status;
+}
+
+__INTERRUPT void TIMER4_IRQHandler(void)
+{
+    uint32_t intf = TIMER_INTF(TIMER4);
+    uint16_t capture = (uint16_t)TIMER_CH3CV(TIMER4);
+
+    TIMER_INTF(TIMER4) = ~(TIMER_INTF_CH3IF | TIMER_INTF_CH3OF);
+
+    if (intf & TIMER_INTF_CH3OF) {
+        // a capture was lost, the window would come out short
+        irctrim_restart();
+    } else if (0U != irctrim_captures++) {
+        // 16-bit difference, a capture interval is well below one counter wrap
+        irctrim_sum += (uint16_t)(capture - irctrim_last);
+        if (irctrim_captures > DIY_IRCTRIM_WINDOW) {
+            irctrim_window_done(irctrim_sum);
+            irctrim_restart();
+        }
+    }
+    irctrim_last = capture;
+}
@@ -0,0 +1,306 @@
+#include <stdint.h>
+#include "diy_gd32vf103_logic.h"
+
+/* DMA target: two halves of GPIO_ISTAT samples, one is compressed while the other fills */
+static uint16_t logic_buf[2U * DIY_LOGIC_HALF_SAMPLES];
+static volatile uint32_t logic_ready = 0U;      // BIT(half) once the DMA has filled it
+static volatile uint8_t logic_overrun = 0U;
+static volatile uint8_t logic_sampling = 0U;    // timer and DMA running
+static uint32_t logic_next = 0U;                // half to compress next
+static uint32_t logic_left = 0U;                // samples still to send
+static uint16_t logic_mask = 0U;
+static uint32_t logic_rate = 0U;
+static diy_logic_state_enum logic_state = DIY_LOGIC_IDLE;
+
+/* run being counted */
+static uint16_t logic_value = 0U;
+static uint32_t logic_run = 0U;
+
+/* output ring: records wait here for the USART0 TX DMA, the indices run freely */
+_Static_assert(0U == (DIY_LOGIC_OUT_BYTES & (DIY_LOGIC_OUT_BYTES - 1U)), "DIY_LOGIC_OUT_BYTES must be a power of two");
+static uint8_t logic_out[DIY_LOGIC_OUT_BYTES];
+static volatile uint32_t logic_out_head = 0U;   // next byte logic_emit() writes
+static volatile uint32_t logic_out_tail = 0U;   // oldest byte not sent yet
+static volatile uint32_t logic_out_dma = 0U;    // bytes of the transfer running from the tail, 0 when idle
+
+/* called from the interrupt and from diy_logic_poll(), only the first call stops */
+static void logic_stop(void)
+{
+    if (0U == logic_sampling) {
+        return;
+    }
+    logic_sampling = 0U;
+
+    TIMER_CTL0(TIMER2) = 0U;
+    TIMER_DMAINTEN(TIMER2) = 0U;
+    DMA0_CHCTL(DIY_LOGIC_DMA_CH) = 0U;
+    diy_clkgate_release(RCU_TIMER2);
+    diy_clkgate_release(RCU_DMA0);
+}
+
+/* start the next transfer from the tail, up to the head or the end of the ring,
+   called with interrupts masked or from the TX interrupt */
+static void logic_out_kick(void)
+{
+    uint32_t start = logic_out_tail & (DIY_LOGIC_OUT_BYTES - 1U);
+    uint32_t count = logic_out_head - logic_out_tail;
+
+    if ((0U != logic_out_dma) || (0U == count)) {
+        return;
+    }
+    if (count > (DIY_LOGIC_OUT_BYTES - start)) {
+        count = DIY_LOGIC_OUT_BYTES - start;
+    }
+    logic_out_dma = count;
+
+    // the counter and address only take writes while the channel is off
+    DMA0_CHCTL(DIY_LOGIC_TX_DMA_CH) &= ~DMA_CHCTL_CHEN;
+    DMA0_CHMADDR(DIY_LOGIC_TX_DMA_CH) = (uint32_t)&logic_out[start];
+    DMA0_CHCNT(DIY_LOGIC_TX_DMA_CH) = count;
+    DMA0_CHCTL(DIY_LOGIC_TX_DMA_CH) |= DMA_CHCTL_CHEN;
+}
+
+/* one record into the output ring, ERROR when it does not fit */
+static ErrStatus logic_emit(uint16_t value, uint32_t run)
+{
+    uint32_t head = logic_out_head;
+    uint32_t irq;
+
+    if ((DIY_LOGIC_OUT_BYTES - (head - logic_out_tail)) < DIY_LOGIC_RECORD_MAX) {
+        return ERROR;
+    }
+
+    logic_out[head++ & (DIY_LOGIC_OUT_BYTES - 1U)] = (uint8_t)value;
+    logic_out[head++ & (DIY_LOGIC_OUT_BYTES - 1U)] = (uint8_t)(value >> 8);
+    while (run >= 0x80U) {
+        logic_out[head++ & (DIY_LOGIC_OUT_BYTES - 1U)] = (uint8_t)(run | 0x80U);
+        run >>= 7;
+    }
+    logic_out[head++ & (DIY_LOGIC_OUT_BYTES - 1U)] = (uint8_t)run;
+
+    irq = diy_irq_save();
+    logic_out_head = head;
+    logic_out_kick();
+    diy_irq_restore(irq);
+
+    return SUCCESS;
+}
+
+/* wait until no more than 'queued' bytes are left in the ring */
+static void logic_out_drain(uint32_t queued)
+{
+    while ((logic_out_head - logic_out_tail) > queued) {
+    }
+}
+
+/* runs carry over from one half to the next, ERROR when the output ring is full */
+static ErrStatus logic_compress(const uint16_t *samples, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++) {
+        uint16_t value = samples[i] & logic_mask;
+
+        if ((value == logic_value) && (0U != logic_run)) {
+            logic_run++;
+        } else {
+            if ((0U != logic_run) && (SUCCESS != logic_emit(logic_value, logic_run))) {
+                return ERROR;
+            }
+            logic_value = value;
+            logic_run = 1U;
+        }
+    }
+    return SUCCESS;
+}
+
+static void logic_finish(diy_logic_state_enum state)
+{
+    // sampling has stopped, so waiting for the ring to drain loses nothing
+    logic_out_drain(DIY_LOGIC_OUT_BYTES - (2U * DIY_LOGIC_RECORD_MAX));
+    if ((DIY_LOGIC_DONE == state) && (0U != logic_run)) {
+        logic_emit(logic_value, logic_run);
+    }
+    logic_emit(0U, 0U);
+    logic_state = state;
+
+    // hand USART0 back to diy_usart_send_byte() once the last byte has left the shift register
+    logic_out_drain(0U);
+    while (0U != logic_out_dma) {
+    }
+    while (0U == (USART_STAT(USART0) & USART_STAT_TC)) {
+    }
+    USART_CTL2(USART0) &= ~USART_CTL2_DENT;
+    diy_eclic_irq_disable(DMA0_Channel3_IRQn);
+    DMA0_CHCTL(DIY_LOGIC_TX_DMA_CH) = 0U;
+    diy_clkgate_release(RCU_DMA0);
+
+    diy_usart_send_string((DIY_LOGIC_DONE == state) ? "\r\nLogic: done\r\n" : "\r\nLogic: overrun, stopped\r\n");
+}
+
+ErrStatus diy_logic_start(uint32_t gpio_periph, uint16_t mask, uint32_t rate_hz, uint32_t samples)
+{
+    uint32_t timer_hz = diy_clock_timer_get(CK_APB1);
+    uint32_t ticks, psc;
+
+    if ((DIY_LOGIC_RUNNING == logic_state) || (0U == samples) ||
+        (0U == rate_hz) || (rate_hz > DIY_LOGIC_RATE_MAX) || (rate_hz > timer_hz)) {
+        return ERROR;
+    }
+
+    // 16-bit prescaler and reload: split the period, the prescaler as small as possible
+    ticks = timer_hz / rate_hz;
+    psc = (ticks - 1U) / 0x10000U;
+    if (psc > 0xFFFFU) {
+        return ERROR;
+    }
+    logic_rate = timer_hz / ((psc + 1U) * (ticks / (psc + 1U)));
+
+    logic_mask = mask;
+    logic_left = samples;
+    logic_next = 0U;
+    logic_ready = 0U;
+    logic_overrun = 0U;
+    logic_run = 0U;
+    logic_out_head = 0U;
+    logic_out_tail = 0U;
+    logic_out_dma = 0U;
+    logic_state = DIY_LOGIC_RUNNING;
+    logic_sampling = 1U;
+
+    diy_usart_send_string("Logic: port ");
+    diy_usart_send_hex(gpio_periph);
+    diy_usart_send_string(" mask ");
+    diy_usart_send_hex(mask);
+    diy_usart_send_string(" now ");
+    diy_usart_send_hex(gpio_input_port_get(gpio_periph) & mask);
+    diy_usart_send_string(", ");
+    diy_usart_send_dec(samples);
+    diy_usart_send_string(" samples at ");
+    diy_usart_send_dec(logic_rate);
+    diy_usart_send_string(" Hz\r\n");
+
+    // one DMA0 reference for the sampling, one for the output until logic_finish()
+    diy_clkgate_acquire(RCU_DMA0);
+    diy_clkgate_acquire(RCU_DMA0);
+    diy_clkgate_acquire(RCU_TIMER2);
+
+    // output ring -> USART0, one byte per TBE request, started by logic_out_kick()
+    DMA0_CHCTL(DIY_LOGIC_TX_DMA_CH) = 0U;
+    DMA0_INTC = DMA_INTF_GIF(DIY_LOGIC_TX_DMA_CH);
+    DMA0_CHPADDR(DIY_LOGIC_TX_DMA_CH) = (uint32_t)&USART_DATA(USART0);
+    DMA0_CHCTL(DIY_LOGIC_TX_DMA_CH) = DMA_CHCTL_DIR | DMA_CHCTL_MNAGA | DMA_CHCTL_FTFIE | DMA_CHCTL_ERRIE;
+    diy_eclic_mode_set(DMA0_Channel3_IRQn, ECLIC_MODE_VECTORED);
+    diy_eclic_irq_enable(DMA0_Channel3_IRQn, DIY_LOGIC_IRQ_LEVEL, 0U);
+    USART_CTL2(USART0) |= USART_CTL2_DENT;
+
+    // circular GPIO_ISTAT -> RAM, one half word per TIMER2 update
+    DMA0_CHCTL(DIY_LOGIC_DMA_CH) = 0U;
+    DMA0_INTC = DMA_INTF_GIF(DIY_LOGIC_DMA_CH);
+    DMA0_CHPADDR(DIY_LOGIC_DMA_CH) = (uint32_t)&GPIO_ISTAT(gpio_periph);
+    DMA0_CHMADDR(DIY_LOGIC_DMA_CH) = (uint32_t)logic_buf;
+    DMA0_CHCNT(DIY_LOGIC_DMA_CH) = 2U * DIY_LOGIC_HALF_SAMPLES;
+    DMA0_CHCTL(DIY_LOGIC_DMA_CH) = DMA_CHCTL_MNAGA | DMA_CHCTL_CMEN |
+                                   DMA_CHCTL_PWIDTH_16BIT | DMA_CHCTL_MWIDTH_16BIT | DMA_CHCTL_PRIO_HIGH |
+                                   DMA_CHCTL_HTFIE | DMA_CHCTL_FTFIE | DMA_CHCTL_ERRIE;
+    DMA0_CHCTL(DIY_LOGIC_DMA_CH) |= DMA_CHCTL_CHEN;
+
+    diy_eclic_mode_set(DMA0_Channel2_IRQn, ECLIC_MODE_VECTORED);
+    diy_eclic_irq_enable(DMA0_Channel2_IRQn, DIY_LOGIC_IRQ_LEVEL, 0U);
+
+    TIMER_CTL0(TIMER2) = 0U;
+    TIMER_PSC(TIMER2) = psc;
+    TIMER_CAR(TIMER2) = (ticks / (psc + 1U)) - 1U;
+    TIMER_SWEVG(TIMER2) = TIMER_SWEVG_UPG;
+    TIMER_DMAINTEN(TIMER2) = TIMER_DMAINTEN_UPDEN;
+    TIMER_CTL0(TIMER2) = TIMER_CTL0_CEN;
+
+    return SUCCESS;
+}
+
+diy_logic_state_enum diy_logic_poll(void)
+{
+    uint32_t count;
+    uint32_t irq;
+    ErrStatus sent;
+
+    if (DIY_LOGIC_RUNNING != logic_state) {
+        return logic_state;
+    }
+    if (0U != logic_overrun) {
+        logic_finish(DIY_LOGIC_OVERRUN);
+        return logic_state;
+    }
+    if (0U == (logic_ready & BIT(logic_next))) {
+        return logic_state;
+    }
+
+    count = (logic_left < DIY_LOGIC_HALF_SAMPLES) ? logic_left : DIY_LOGIC_HALF_SAMPLES;
+    sent = logic_compress(&logic_buf[logic_next * DIY_LOGIC_HALF_SAMPLES], count);
+    logic_left -= count;
+
+    // hand the half back to the DMA
+    irq = diy_irq_save();
+    logic_ready &= ~BIT(logic_next);
+    if ((0U == logic_left) || (SUCCESS != sent)) {
+        logic_stop();
+    }
+    diy_irq_restore(irq);
+    logic_next ^= 1U;
+
+    if ((SUCCESS != sent) || (0U != logic_overrun)) {
+        // the output ring is full, or the DMA came back to this half while it was being compressed
+        logic_finish(DIY_LOGIC_OVERRUN);
+    } else if (0U == logic_left) {
+        logic_finish(DIY_LOGIC_DONE);
+    }
+
+    return logic_state;
+}
+
+uint32_t diy_logic_rate_get(void)
+{
+    return logic_rate;
+}
+
+/* a half filled and the DMA moves on to the other one, which must have been compressed by now */
+static void logic_half_done(uint32_t half)
+{
+    if (logic_ready & BIT(half ^ 1U)) {
+        logic_stop();
+        logic_overrun = 1U;
+        return;
+    }
+    logic_ready |= BIT(half);
+}
+
+__INTERRUPT void DMA0_Channel2_IRQHandler(void)
+{
+    uint32_t intf = DMA0_INTF;
+
+    // the global flag clears all four flags of the channel
+    DMA0_INTC = DMA_INTF_GIF(DIY_LOGIC_DMA_CH);
+
+    if (0U == logic_sampling) {
+        return;
+    }
+    if (intf & DMA_INTF_ERRIF(DIY_LOGIC_DMA_CH)) {
+        logic_stop();
+        logic_overrun = 1U;
+        return;
+    }
+    if (intf & DMA_INTF_HTFIF(DIY_LOGIC_DMA_CH)) {
+        logic_half_done(0U);
+    }
+    if ((0U != logic_sampling) && (intf & DMA_INTF_FTFIF(DIY_LOGIC_DMA_CH))) {
+        logic_half_done(1U);
+    }
+}
+
+__INTERRUPT void DMA0_Channel3_IRQHandler(void)
+{
+    DMA0_INTC = DMA_INTF_GIF(DIY_LOGIC_TX_DMA_CH);
+
+    // transfer done (or failed on the bus, its bytes are dropped): move on to the next part
+    logic_out_tail += logic_out_dma;
+    logic_out_dma = 0U;
+    logic_out_kick();
+}
@@ -0,0 +1,147 @@
+#include <stdint.h>
+// the umbrella header first: crash.h embeds diy_retain_header_t
+#include "gd32vf103.h"
+
+#define RETAIN_PAYLOAD_WORDS(size)    (((size) - sizeof(diy_retain_header_t)) / sizeof(uint32_t))
+
+static __NOINIT diy_retain_sys_t retain_sys;
+
+static uint32_t reset_flags = 0U;
+static uint8_t reset_flags_latched = 0U;
+static uint8_t retain_warm = 0U;
+static uint8_t retain_ready = 0U;
+
+static uint32_t retain_crc(diy_retain_header_t *header, uint32_t size)
+{
+    return diy_crc32_calc((uint32_t *)(header + 1), RETAIN_PAYLOAD_WORDS(size));
+}
+
+ErrStatus diy_retain_check(diy_retain_header_t *header, uint32_t size, uint32_t magic)
+{
+    // RAM content does not survive a power-on reset, even if it looks valid
+    if (DIY_RESET_POWER == diy_reset_cause_get()) {
+        return ERROR;
+    }
+    if ((magic != header->magic) || (size != header->length)) {
+        return ERROR;
+    }
+
+    return (header->crc == retain_crc(header, size)) ? SUCCESS : ERROR;
+}
+
+void diy_retain_commit(diy_retain_header_t *header, uint32_t size, uint32_t magic)
+{
+    uint32_t irq = diy_irq_save();
+
+    header->magic = magic;
+    header->length = size;
+    header->crc = retain_crc(header, size);
+
+    diy_irq_restore(irq);
+}
+
+void diy_retain_invalidate(diy_retain_header_t *header)
+{
+    header->magic = 0U;
+}
+
+diy_reset_cause_enum diy_reset_cause_get(void)
+{
+    if (!reset_flags_latched) {
+        reset_flags = RCU_RSTSCK;
+        RCU_RSTSCK |= RCU_RSTSCK_RSTFC;
+        reset_flags_latched = 1U;
+    }
+
+    // several flags can be set, the most destructive one wins
+    if (reset_flags & RCU_RSTSCK_PORRSTF) {
+        return DIY_RESET_POWER;
+    } else if (reset_flags & RCU_RSTSCK_LPRSTF) {
+        return DIY_RESET_LOWPOWER;
+    } else if (reset_flags & RCU_RSTSCK_FWDGTRSTF) {
+        return DIY_RESET_FWDGT;
+    } else if (reset_flags & RCU_RSTSCK_WWDGTRSTF) {
+        return DIY_RESET_WWDGT;
+    } else if (reset_flags & RCU_RSTSCK_SWRSTF) {
+        return DIY_RESET_SOFTWARE;
+    } else {
+        return DIY_RESET_PIN;
+    }
+}
+
+char *diy_reset_cause_name(diy_reset_cause_enum cause)
+{
+    switch (cause) {
+    case DIY_RESET_POWER:
+        return (char *)"power-on";
+    case DIY_RESET_LOWPOWER:
+        return (char *)"low-power";
+    case DIY_RESET_PIN:
+        return (char *)"pin";
+    case DIY_RESET_SOFTWARE:
+        return (char *)"software";
+    case DIY_RESET_FWDGT:
+        return (char *)"FWDGT";
+    case DIY_RESET_WWDGT:
+        return (char *)"WWDGT";
+    default:
+        return (char *)"unknown";
+    }
+}
+
+ErrStatus diy_retain_warm_get(void)
+{
+    return retain_warm ? SUCCESS : ERROR;
+}
+
+void diy_retain_init(void)
+{
+    if (SUCCESS == diy_retain_check(&retain_sys.header, sizeof(retain_sys), DIY_RETAIN_MAGIC)) {
+        retain_warm = 1U;
+        retain_sys.warm_count++;
+    } else {
+        // cold start, nothing retained can be trusted
+        retain_warm = 0U;
+        retain_sys.boot_count = 0U;
+        retain_sys.warm_count = 0U;
+        retain_sys.log_index = 0U;
+        for (uint32_t i = 0U; i < DIY_RETAIN_LOG_SIZE; i++) {
+            retain_sys.log[i] = 0U;
+        }
+    }
+    retain_sys.boot_count++;
+
+    diy_retain_commit(&retain_sys.header, sizeof(retain_sys), DIY_RETAIN_MAGIC);
+    retain_ready = 1U;
+}
+
+diy_retain_sys_t *diy_retain_sys_get(void)
+{
+    return &retain_sys;
+}
+
+void diy_retain_log_add(uint32_t code)
+{
+    uint32_t irq;
+
+    // the block is not validated yet, do not make garbage look valid
+    if (!retain_ready) {
+        return;
+    }
+
+    irq = diy_irq_save();
+
+    retain_sys.log[retain_sys.log_index % DIY_RETAIN_LOG_SIZE] = code;
+    retain_sys.log_index = (retain_sys.log_index + 1U) % DIY_RETAIN_LOG_SIZE;
+    diy_retain_commit(&retain_sys.header, sizeof(retain_sys), DIY_RETAIN_MAGIC);
+
+    diy_irq_restore(irq);
+}
+
+void diy_system_reset(void)
+{
+    diy_irq_save();
+    SYSTIMER_MSFTRST = SYSTIMER_MSFTRST_KEY;
+    while (1) {
+    }
+}
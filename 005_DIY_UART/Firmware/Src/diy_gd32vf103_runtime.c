@@ -0,0 +1,45 @@
+#include <stdint.h>
+#include "diy_gd32vf103_runtime.h"
+
+/* provided by gd32vf103xb.ld */
+extern diy_runtime_func_t __preinit_array_start[];
+extern diy_runtime_func_t __preinit_array_end[];
+extern diy_runtime_func_t __init_array_start[];
+extern diy_runtime_func_t __init_array_end[];
+extern diy_runtime_func_t __fini_array_start[];
+extern diy_runtime_func_t __fini_array_end[];
+
+/* object handle for __cxa_atexit(), static objects have no DSO; weak, crtbegin.o brings its own */
+__attribute__((weak)) void *__dso_handle = &__dso_handle;
+
+void diy_runtime_init(void)
+{
+    // runs on IRC8M with interrupts disabled, before SystemInit()
+    for (diy_runtime_func_t *func = __preinit_array_start; func < __preinit_array_end; func++) {
+        (*func)();
+    }
+    for (diy_runtime_func_t *func = __init_array_start; func < __init_array_end; func++) {
+        (*func)();
+    }
+}
+
+void diy_runtime_fini(void)
+{
+    for (diy_runtime_func_t *func = __fini_array_end; func > __fini_array_start; ) {
+        (*--func)();
+    }
+}
+
+__attribute__((weak)) void __cxa_pure_virtual(void)
+{
+    // a pure virtual call is a bug, trap into the crash handler
+    __asm__ volatile ("ebreak");
+    while (1) {
+    }
+}
+
+__attribute__((weak)) int __cxa_atexit(void (*func)(void *), void *arg, void *dso)
+{
+    // firmware never exits, static destructors registered at run time are dropped
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <stdint.h>
+#include "diy_gd32vf103_stack.h"
+
+/* provided by gd32vf103xb.ld */
+extern uint32_t _sstack[];
+extern uint32_t _sp[];
+
+/* lowest word index found touched so far, the scan never has to look above it */
+static uint32_t stack_low_index = 0xFFFFFFFFU;
+static volatile ErrStatus stack_guard_status = SUCCESS;
+
+uint32_t diy_stack_size_get(void)
+{
+    return (uint32_t)((uint8_t *)_sp - (uint8_t *)_sstack);
+}
+
+uint32_t diy_stack_used_get(void)
+{
+    uint32_t sp;
+
+    __asm__ volatile ("mv %0, sp" : "=r"(sp));
+    return (uint32_t)_sp - sp;
+}
+
+uint32_t diy_stack_peak_get(void)
+{
+    uint32_t words = (uint32_t)(_sp - _sstack);
+    uint32_t limit = (stack_low_index < words) ? stack_low_index : words;
+    uint32_t i;
+
+    // the stack grows down, so the first non-pattern word from the bottom marks the peak
+    for (i = 0U; i < limit; i++) {
+        if (DIY_STACK_PAINT_PATTERN != _sstack[i]) {
+            break;
+        }
+    }
+    stack_low_index = i;
+
+    return (words - i) * sizeof(uint32_t);
+}
+
+ErrStatus diy_stack_guard_check(void)
+{
+    for (uint32_t i = 0U; i < DIY_STACK_GUARD_WORDS; i++) {
+        if (DIY_STACK_PAINT_PATTERN != _sstack[i]) {
+            stack_guard_status = ERROR;
+        }
+    }
+
+    return stack_guard_status;
+}
+
+void diy_stack_guard_tick(void)
+{
+    (void)diy_stack_guard_check();
+}
+
+ErrStatus diy_stack_guard_status_get(void)
+{
+    return stack_guard_status;
+}
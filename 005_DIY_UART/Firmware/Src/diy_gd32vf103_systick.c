@@ -0,0 +1,96 @@
+#include <stdint.h>
+#include "diy_gd32vf103_systick.h"
+
+static volatile uint32_t systick_count = 0U;
+static uint32_t systick_rate = 0U;
+static uint32_t systick_period = 0U;
+static diy_systick_hook_t systick_hooks[DIY_SYSTICK_HOOKS_MAX];
+static uint32_t systick_hook_count = 0U;
+
+static uint64_t systick_mtime_get(void)
+{
+    uint32_t hi, lo;
+
+    do {
+        hi = SYSTIMER_MTIME_HI;
+        lo = SYSTIMER_MTIME_LO;
+    } while (hi != SYSTIMER_MTIME_HI);
+
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static void systick_mtimecmp_set(uint64_t value)
+{
+    /* park the high word first so no spurious match happens in between */
+    SYSTIMER_MTIMECMP_HI = 0xFFFFFFFFU;
+    SYSTIMER_MTIMECMP_LO = (uint32_t)value;
+    SYSTIMER_MTIMECMP_HI = (uint32_t)(value >> 32);
+}
+
+void diy_systick_reload(void)
+{
+    systick_period = (SystemCoreClock / SYSTIMER_CLOCK_DIV) / systick_rate;
+    systick_mtimecmp_set(systick_mtime_get() + systick_period);
+}
+
+void diy_systick_init(uint32_t tick_hz)
+{
+    systick_rate = tick_hz;
+    diy_systick_reload();
+
+    diy_eclic_mode_set(CLIC_INT_TMR, ECLIC_MODE_VECTORED);
+    diy_eclic_irq_enable(CLIC_INT_TMR, DIY_SYSTICK_IRQ_LEVEL, 0U);
+}
+
+ErrStatus diy_systick_hook_add(diy_systick_hook_t hook)
+{
+    ErrStatus status = ERROR;
+    uint32_t irq = diy_irq_save();
+
+    if (systick_hook_count < DIY_SYSTICK_HOOKS_MAX) {
+        systick_hooks[systick_hook_count++] = hook;
+        status = SUCCESS;
+    }
+
+    diy_irq_restore(irq);
+    return status;
+}
+
+uint32_t diy_systick_get(void)
+{
+    return systick_count;
+}
+
+uint32_t diy_systick_rate_get(void)
+{
+    return systick_rate;
+}
+
+void diy_systick_delay(uint32_t ticks)
+{
+    uint32_t start = systick_count;
+
+    while ((systick_count - start) < ticks);
+}
+
+__INTERRUPT void eclic_mtip_handler(void)
+{
+    uint64_t cmp;
+
+    /* advance from the previous compare value so the tick does not drift */
+    cmp = ((uint64_t)SYSTIMER_MTIMECMP_HI << 32) | SYSTIMER_MTIMECMP_LO;
+    systick_mtimecmp_set(cmp + systick_period);
+
+    systick_count++;
+    for (uint32_t i = 0U; i < systick_hook_count; i++) {
+        systick_hooks[i]();
+    }
+}
+
+void diy_systick_clock_notify(uint32_t event, uint32_t hz)
+{
+    // mtime runs from the core clock, keep the tick rate
+    if ((DIY_CLOCK_EVENT_POST == event) && (0U != systick_rate)) {
+        diy_systick_reload();
+    }
+}
@@ -1,6 +1,9 @@
 #include <stdint.h>
 #include "diy_gd32vf103_usart.h"
 
+/* last requested baud rate, reapplied after a clock change */
+static uint32_t usart0_baudrate = 0U;
+
 void diy_usart_deinit(uint32_t usart_periph)
 {
     switch (usart_periph)
@@ -24,6 +27,7 @@ void diy_usart_baudrate_set(uint32_t usart_periph, uint32_t baudval)
     {
     case USART0:
         uclk = rcu_clock_freq_get(CK_APB2);
+        usart0_baudrate = baudval;
         break;
     
     default:
@@ -187,13 +191,14 @@ void diy_usart_config_f(uint32_t usart_periph, const diy_usart_config_t *usart_c
     
 }
 
-void diy_usart_send_byte(uint8_t data)
+// hot path: runs from SRAM and touches the registers directly, no flash calls
+__RAMFUNC void diy_usart_send_byte(uint8_t data)
 {
-    while (RESET == diy_usart_flag_get(USART0, USART_FLAG_TBE));
+    while (0U == (USART_STAT(USART0) & USART_STAT_TBE));
     
-    diy_usart_data_transmit(USART0, data);
+    USART_DATA(USART0) = USART_DATA_DATA & data;
 
-    while (RESET == diy_usart_flag_get(USART0, USART_FLAG_TC));
+    while (0U == (USART_STAT(USART0) & USART_STAT_TC));
     
 }
 
@@ -215,4 +220,40 @@ uint8_t diy_usart_receive_byte(void)
 uint8_t diy_usart_is_data_available(void)
 {
     return (diy_usart_flag_get(USART0, USART_FLAG_RBNE) == SET) ? 1 : 0;
-}
\ No newline at end of file
+}
+
+void diy_usart_send_dec(uint32_t value)
+{
+    char digits[10];
+    uint8_t count = 0;
+
+    do {
+        digits[count++] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value);
+
+    while (count) {
+        diy_usart_send_byte(digits[--count]);
+    }
+}
+
+void diy_usart_send_hex(uint32_t value)
+{
+    static const char hex[] = "0123456789ABCDEF";
+
+    diy_usart_send_string("0x");
+    for (int8_t shift = 28; shift >= 0; shift -= 4) {
+        diy_usart_send_byte(hex[(value >> shift) & 0x0FU]);
+    }
+}
+void diy_usart_clock_notify(uint32_t event, uint32_t hz)
+{
+    if (DIY_CLOCK_EVENT_PRE == event) {
+        // let the last frame leave on the old baud divider
+        if (USART_CTL0(USART0) & USART_CTL0_UEN) {
+            while (!(USART_STAT(USART0) & USART_STAT_TC));
+        }
+    } else if (0U != usart0_baudrate) {
+        diy_usart_baudrate_set(USART0, usart0_baudrate);
+    }
+}
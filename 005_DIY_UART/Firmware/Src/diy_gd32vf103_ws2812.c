@@ -0,0 +1,263 @@
+#include <stdint.h>
+#include "diy_gd32vf103_ws2812.h"
+
+
+static uint32_t ws2812_port = GPIOA;
+static uint32_t ws2812_pin = 0U;
+static diy_ws2812_timing_t ws2812_timing = DIY_WS2812_TIMING_WS2812B;
+static volatile uint32_t ws2812_end = 0U;          // mcycle when the line last went idle
+
+/* DMA stream: two halves of BOP words, one is refilled while the other is on the line */
+static uint32_t ws2812_dma_buf[2U * DIY_WS2812_STREAM_WORDS];
+static uint8_t ws2812_has_data[2];
+
+/* bit layout of the stream, from ws2812_slots_solve(): the line rises in slot 0 and falls in
+   slot 'fall0' for a 0 bit, 'fall1' for a 1 bit */
+static uint32_t ws2812_slots = 0U;
+static uint32_t ws2812_fall0 = 0U;
+static uint32_t ws2812_fall1 = 0U;
+static uint32_t ws2812_half_bytes = 0U;        // bytes encoded per half buffer
+static uint32_t ws2812_half_words = 0U;        // words used per half buffer
+static const uint8_t *ws2812_src;
+static uint32_t ws2812_left = 0U;
+static volatile uint8_t ws2812_streaming = 0U;
+
+static uint32_t ws2812_cycles(uint32_t hz, uint32_t ns)
+{
+    return (uint32_t)(((uint64_t)hz * ns + 500000000U) / 1000000000U);
+}
+
+/* the frame before has to be latched by a long enough low level */
+static void ws2812_latch_wait(void)
+{
+    uint32_t reset = (SystemCoreClock / 1000000U) * ws2812_timing.reset_us;
+
+    while ((diy_cycle_get() - ws2812_end) < reset) {
+    }
+}
+
+/* edges are placed on mcycle deadlines, so the speed of the code in between only has to
+   fit in the low time; O2 keeps the polling loop short, which bounds the edge jitter */
+__RAMFUNC __attribute__((optimize("O2")))
+static void ws2812_bits(volatile uint32_t *bop, uint32_t mask, const uint8_t *data, uint32_t len,
+                        uint32_t t0h, uint32_t t1h, uint32_t period)
+{
+    uint32_t start = read_csr(CSR_MCYCLE);
+
+    while (len--) {
+        uint32_t byte = *data++;
+
+        for (uint32_t bit = 0x80U; 0U != bit; bit >>= 1) {
+            uint32_t high = (byte & bit) ? t1h : t0h;
+
+            while ((int32_t)(read_csr(CSR_MCYCLE) - start) < 0) {
+            }
+            *bop = mask;
+            while ((read_csr(CSR_MCYCLE) - start) < high) {
+            }
+            *bop = mask << 16;
+            start += period;
+        }
+    }
+}
+
+void diy_ws2812_init(uint32_t gpio_periph, uint32_t pin, const diy_ws2812_timing_t *timing)
+{
+    ws2812_port = gpio_periph;
+    ws2812_pin = pin;
+    ws2812_timing = *timing;
+
+    GPIO_BC(gpio_periph) = pin;
+    gpio_init(gpio_periph, GPIO_MODE_OUT_PP, GPIO_OSPEED_50MHZ, pin);
+    ws2812_end = diy_cycle_get();
+
+    diy_eclic_mode_set(DMA0_Channel1_IRQn, ECLIC_MODE_VECTORED);
+    diy_eclic_irq_enable(DMA0_Channel1_IRQn, DIY_WS2812_IRQ_LEVEL, 0U);
+}
+
+ErrStatus diy_ws2812_send(const uint8_t *data, uint32_t len)
+{
+    uint32_t hz = SystemCoreClock;
+    uint32_t t0h = ws2812_cycles(hz, ws2812_timing.t0h_ns);
+    uint32_t irq;
+
+    if ((0U != ws2812_streaming) || (t0h < DIY_WS2812_MIN_T0H_CYCLES)) {
+        return ERROR;
+    }
+
+    ws2812_latch_wait();
+    // any interrupt longer than the low time would stretch a bit into a latch
+    irq = diy_irq_save();
+    ws2812_bits(&GPIO_BOP(ws2812_port), ws2812_pin, data, len, t0h,
+                ws2812_cycles(hz, ws2812_timing.t1h_ns), ws2812_cycles(hz, ws2812_timing.period_ns));
+    ws2812_end = diy_cycle_get();
+    diy_irq_restore(irq);
+
+    return SUCCESS;
+}
+
+/* slot where an edge 'ns' after the rise falls, 0 if no slot is within DIY_WS2812_TOLERANCE_NS */
+static uint32_t ws2812_slot_place(uint64_t slot_ps, uint32_t ns)
+{
+    uint64_t ps = (uint64_t)ns * 1000U;
+    uint64_t slot = (ps + slot_ps / 2U) / slot_ps;
+    uint64_t placed = slot * slot_ps;
+    uint64_t error = (placed > ps) ? (placed - ps) : (ps - placed);
+
+    return (error <= ((uint64_t)DIY_WS2812_TOLERANCE_NS * 1000U)) ? (uint32_t)slot : 0U;
+}
+
+/* fewest slots per bit that place both high times, and the timer reload for one slot */
+static ErrStatus ws2812_slots_solve(uint32_t timer_hz, uint32_t *slot_cycles)
+{
+    uint32_t period = ws2812_cycles(timer_hz, ws2812_timing.period_ns);
+
+    for (uint32_t slots = 2U; slots <= DIY_WS2812_SLOTS_MAX; slots++) {
+        uint32_t cycles = (period + slots / 2U) / slots;
+        uint64_t slot_ps = ((uint64_t)cycles * 1000000000000ULL) / timer_hz;
+        uint32_t fall0, fall1;
+
+        // each slot has to cover one DMA transfer into the GPIO
+        if (cycles < DIY_WS2812_DMA_MIN_CYCLES) {
+            break;
+        }
+        fall0 = ws2812_slot_place(slot_ps, ws2812_timing.t0h_ns);
+        fall1 = ws2812_slot_place(slot_ps, ws2812_timing.t1h_ns);
+        // both edges inside the bit, a 1 stays high longer than a 0
+        if ((0U == fall0) || (fall1 <= fall0) || (fall1 >= slots)) {
+            continue;
+        }
+
+        ws2812_slots = slots;
+        ws2812_fall0 = fall0;
+        ws2812_fall1 = fall1;
+        ws2812_half_bytes = DIY_WS2812_STREAM_WORDS / (8U * slots);
+        ws2812_half_words = ws2812_half_bytes * 8U * slots;
+        *slot_cycles = cycles;
+        return SUCCESS;
+    }
+
+    return ERROR;
+}
+
+/* BOP words for the next bytes: set in the first slot, reset in the fall slot of the bit;
+   zero words leave the line low once the data runs out */
+static void ws2812_encode(uint32_t half)
+{
+    uint32_t *word = &ws2812_dma_buf[half * ws2812_half_words];
+    uint32_t *end = word + ws2812_half_words;
+    uint32_t count = (ws2812_left < ws2812_half_bytes) ? ws2812_left : ws2812_half_bytes;
+    uint32_t set = ws2812_pin;
+    uint32_t reset = ws2812_pin << 16;
+
+    ws2812_has_data[half] = (0U != count) ? 1U : 0U;
+    ws2812_left -= count;
+
+    while (count--) {
+        uint32_t byte = *ws2812_src++;
+
+        for (uint32_t bit = 0x80U; 0U != bit; bit >>= 1) {
+            uint32_t fall = (byte & bit) ? ws2812_fall1 : ws2812_fall0;
+
+            word[0] = set;
+            for (uint32_t slot = 1U; slot < ws2812_slots; slot++) {
+                word[slot] = (slot == fall) ? reset : 0U;
+            }
+            word += ws2812_slots;
+        }
+    }
+    while (word < end) {
+        *word++ = 0U;
+    }
+}
+
+static void ws2812_stop(void)
+{
+    TIMER_CTL0(TIMER1) = 0U;
+    TIMER_DMAINTEN(TIMER1) = 0U;
+    DMA0_CHCTL(DIY_WS2812_DMA_CH) = 0U;
+    diy_clkgate_release(RCU_TIMER1);
+    diy_clkgate_release(RCU_DMA0);
+
+    ws2812_end = diy_cycle_get();
+    ws2812_streaming = 0U;
+}
+
+ErrStatus diy_ws2812_stream(const uint8_t *data, uint32_t len)
+{
+    uint32_t slot;
+
+    if ((0U != ws2812_streaming) || (0U == len) ||
+        (SUCCESS != ws2812_slots_solve(diy_clock_timer_get(CK_APB1), &slot))) {
+        return ERROR;
+    }
+
+    ws2812_latch_wait();
+    ws2812_src = data;
+    ws2812_left = len;
+    ws2812_encode(0U);
+    ws2812_encode(1U);
+    ws2812_streaming = 1U;
+
+    diy_clkgate_acquire(RCU_DMA0);
+    diy_clkgate_acquire(RCU_TIMER1);
+
+    // circular memory -> GPIO_BOP, one word per TIMER1 update
+    DMA0_CHCTL(DIY_WS2812_DMA_CH) = 0U;
+    DMA0_INTC = DMA_INTF_GIF(DIY_WS2812_DMA_CH);
+    DMA0_CHPADDR(DIY_WS2812_DMA_CH) = (uint32_t)&GPIO_BOP(ws2812_port);
+    DMA0_CHMADDR(DIY_WS2812_DMA_CH) = (uint32_t)ws2812_dma_buf;
+    DMA0_CHCNT(DIY_WS2812_DMA_CH) = 2U * ws2812_half_words;
+    DMA0_CHCTL(DIY_WS2812_DMA_CH) = DMA_CHCTL_DIR | DMA_CHCTL_MNAGA | DMA_CHCTL_CMEN |
+                                    DMA_CHCTL_PWIDTH_32BIT | DMA_CHCTL_MWIDTH_32BIT | DMA_CHCTL_PRIO_ULTRA_HIGH |
+                                    DMA_CHCTL_HTFIE | DMA_CHCTL_FTFIE | DMA_CHCTL_ERRIE;
+    DMA0_CHCTL(DIY_WS2812_DMA_CH) |= DMA_CHCTL_CHEN;
+
+    // load PSC/CAR before the DMA request is enabled, so the first word waits one slot
+    TIMER_CTL0(TIMER1) = 0U;
+    TIMER_PSC(TIMER1) = 0U;
+    TIMER_CAR(TIMER1) = slot - 1U;
+    TIMER_SWEVG(TIMER1) = TIMER_SWEVG_UPG;
+    TIMER_DMAINTEN(TIMER1) = TIMER_DMAINTEN_UPDEN;
+    TIMER_CTL0(TIMER1) = TIMER_CTL0_CEN;
+
+    return SUCCESS;
+}
+
+FlagStatus diy_ws2812_busy(void)
+{
+    return ws2812_streaming ? SET : RESET;
+}
+
+/* one half went out, the other is on the line now */
+static void ws2812_half_done(uint32_t half)
+{
+    if (0U == ws2812_streaming) {
+        return;
+    }
+    if (0U == ws2812_has_data[half ^ 1U]) {
+        // only no-op words left, the last bit has already ended low
+        ws2812_stop();
+        return;
+    }
+    ws2812_encode(half);
+}
+
+__INTERRUPT void DMA0_Channel1_IRQHandler(void)
+{
+    uint32_t intf = DMA0_INTF;
+
+    // the global flag clears all four flags of the channel
+    DMA0_INTC = DMA_INTF_GIF(DIY_WS2812_DMA_CH);
+
+    if (intf & DMA_INTF_ERRIF(DIY_WS2812_DMA_CH)) {
+        ws2812_stop();
+        return;
+    }
+    if (intf & DMA_INTF_HTFIF(DIY_WS2812_DMA_CH)) {
+        ws2812_half_done(0U);
+    }
+    if (intf & DMA_INTF_FTFIF(DIY_WS2812_DMA_CH)) {
+        ws2812_half_done(1U);
+    }
+}
@@ -32,6 +32,8 @@ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSI
 OF SUCH DAMAGE.
 */
 
+/* the umbrella header first: diy_gd32vf103_bench.h uses gpio_init_parameter_struct */
+#include "gd32vf103.h"
 #include "gd32vf103_gpio.h"
 
 #define AFIO_EXTI_SOURCE_MASK              ((uint8_t)0x03U)         /*!< AFIO exti source selection mask*/  
@@ -95,6 +97,76 @@ void gpio_afio_deinit(void)
     rcu_periph_reset_disable(RCU_AFRST);
 }
 
+/* CTL0/CTL1 masks and values of a batch of pins, plus the OCTL bits of IPU/IPD pins */
+typedef struct {
+    uint32_t ctl_mask[2];
+    uint32_t ctl_value[2];
+    uint32_t pull_up;
+    uint32_t pull_down;
+} gpio_ctl_batch_struct;
+
+/*!
+    \brief      add pins to a CTL batch, no register is touched
+    \param[in]  batch: masks and values built so far
+    \param[in]  mode, speed, pin: as for gpio_init()
+    \param[out] batch: updated masks and values
+    \retval     none
+*/
+static void gpio_ctl_batch_add(gpio_ctl_batch_struct *batch, uint32_t mode, uint32_t speed,
+        uint32_t pin)
+{
+    uint16_t i;
+    uint32_t temp_mode = 0U;
+
+    /* GPIO mode configuration */
+    temp_mode = (uint32_t) (mode & ((uint32_t) 0x0FU));
+
+    /* GPIO speed configuration */
+    if (((uint32_t) 0x00U) != ((uint32_t) mode & ((uint32_t) 0x10U))) {
+        /* output mode max speed:10MHz,2MHz,50MHz */
+        temp_mode |= (uint32_t) speed;
+    }
+
+    /* pins 0..7 go to GPIO_CTL0, pins 8..15 to GPIO_CTL1 */
+    for (i = 0U; i < 16U; i++) {
+        if ((1U << i) & pin) {
+            batch->ctl_mask[i >> 3] |= GPIO_MODE_MASK(i & 7U);
+            batch->ctl_value[i >> 3] |= GPIO_MODE_SET(i & 7U, temp_mode);
+        }
+    }
+
+    /* IPD or IPU select the pull through the OCTL bit */
+    if (GPIO_MODE_IPD == mode) {
+        batch->pull_down |= pin;
+    } else if (GPIO_MODE_IPU == mode) {
+        batch->pull_up |= pin;
+    }
+}
+
+/*!
+    \brief      write a CTL batch, each register at most once
+    \param[in]  gpio_periph: GPIOx(x = A,B,C,D,E)
+    \param[in]  batch: masks and values from gpio_ctl_batch_add()
+    \param[out] none
+    \retval     none
+*/
+static void gpio_ctl_batch_write(uint32_t gpio_periph, const gpio_ctl_batch_struct *batch)
+{
+    /* pull direction first, so the pins come up pulled the right way */
+    if (batch->pull_down) {
+        GPIO_BC(gpio_periph) = batch->pull_down;
+    }
+    if (batch->pull_up) {
+        GPIO_BOP(gpio_periph) = batch->pull_up;
+    }
+    if (batch->ctl_mask[0]) {
+        GPIO_CTL0(gpio_periph) = (GPIO_CTL0(gpio_periph) & ~batch->ctl_mask[0]) | batch->ctl_value[0];
+    }
+    if (batch->ctl_mask[1]) {
+        GPIO_CTL1(gpio_periph) = (GPIO_CTL1(gpio_periph) & ~batch->ctl_mask[1]) | batch->ctl_value[1];
+    }
+}
+
 /*!
     \brief      GPIO parameter initialization
     \param[in]  gpio_periph: GPIOx(x = A,B,C,D,E)
@@ -123,66 +195,42 @@ void gpio_afio_deinit(void)
 void gpio_init(uint32_t gpio_periph, uint32_t mode, uint32_t speed,
         uint32_t pin)
 {
-    uint16_t i;
-    uint32_t temp_mode = 0U;
-    uint32_t reg = 0U;
+    gpio_ctl_batch_struct batch = {0U};
 
-    /* GPIO mode configuration */
-    temp_mode = (uint32_t) (mode & ((uint32_t) 0x0FU));
+    gpio_ctl_batch_add(&batch, mode, speed, pin);
+    gpio_ctl_batch_write(gpio_periph, &batch);
+}
 
-    /* GPIO speed configuration */
-    if (((uint32_t) 0x00U) != ((uint32_t) mode & ((uint32_t) 0x10U))) {
-        /* output mode max speed:10MHz,2MHz,50MHz */
-        temp_mode |= (uint32_t) speed;
-    }
+/*!
+    \brief      GPIO parameter initialization for a whole pin map, one CTL0/CTL1 write per port
+    \param[in]  table: entries as for gpio_init(), several entries may share a port
+    \param[in]  count: number of entries in table
+    \param[out] none
+    \retval     none
+*/
+void gpio_init_many(const gpio_init_parameter_struct *table, uint32_t count)
+{
+    uint32_t i, j;
 
-    /* configure the eight low port pins with GPIO_CTL0 */
-    for (i = 0U; i < 8U; i++) {
-        if ((1U << i) & pin) {
-            reg = GPIO_CTL0(gpio_periph);
-
-            /* clear the specified pin mode bits */
-            reg &= ~GPIO_MODE_MASK(i);
-            /* set the specified pin mode bits */
-            reg |= GPIO_MODE_SET(i, temp_mode);
-
-            /* set IPD or IPU */
-            if (GPIO_MODE_IPD == mode) {
-                /* reset the corresponding OCTL bit */
-                GPIO_BC(gpio_periph) = (uint32_t) ((1U << i) & pin);
-            } else {
-                /* set the corresponding OCTL bit */
-                if (GPIO_MODE_IPU == mode) {
-                    GPIO_BOP(gpio_periph) = (uint32_t) ((1U << i) & pin);
-                }
+    for (i = 0U; i < count; i++) {
+        gpio_ctl_batch_struct batch = {0U};
+
+        /* a port already written with an earlier entry is done */
+        for (j = 0U; j < i; j++) {
+            if (table[j].gpio_periph == table[i].gpio_periph) {
+                break;
             }
-            /* set GPIO_CTL0 register */
-            GPIO_CTL0(gpio_periph) = reg;
         }
-    }
-    /* configure the eight high port pins with GPIO_CTL1 */
-    for (i = 8U; i < 16U; i++) {
-        if ((1U << i) & pin) {
-            reg = GPIO_CTL1(gpio_periph);
-
-            /* clear the specified pin mode bits */
-            reg &= ~GPIO_MODE_MASK(i - 8U);
-            /* set the specified pin mode bits */
-            reg |= GPIO_MODE_SET(i - 8U, temp_mode);
-
-            /* set IPD or IPU */
-            if (GPIO_MODE_IPD == mode) {
-                /* reset the corresponding OCTL bit */
-                GPIO_BC(gpio_periph) = (uint32_t) ((1U << i) & pin);
-            } else {
-                /* set the corresponding OCTL bit */
-                if (GPIO_MODE_IPU == mode) {
-                    GPIO_BOP(gpio_periph) = (uint32_t) ((1U << i) & pin);
-                }
+        if (j < i) {
+            continue;
+        }
+        /* gather this and every later entry for the same port into one batch */
+        for (j = i; j < count; j++) {
+            if (table[j].gpio_periph == table[i].gpio_periph) {
+                gpio_ctl_batch_add(&batch, table[j].mode, table[j].speed, table[j].pin);
             }
-            /* set GPIO_CTL1 register */
-            GPIO_CTL1(gpio_periph) = reg;
         }
+        gpio_ctl_batch_write(table[i].gpio_periph, &batch);
     }
 }
 
@@ -195,7 +243,7 @@ void gpio_init(uint32_t gpio_periph, uint32_t mode, uint32_t speed,
     \param[out] none
     \retval     none
 */
-void gpio_bit_set(uint32_t gpio_periph, uint32_t pin)
+__RAMFUNC void gpio_bit_set(uint32_t gpio_periph, uint32_t pin)
 {
     GPIO_BOP(gpio_periph) = (uint32_t) pin;
 }
@@ -209,7 +257,7 @@ void gpio_bit_set(uint32_t gpio_periph, uint32_t pin)
     \param[out] none
     \retval     none
 */
-void gpio_bit_reset(uint32_t gpio_periph, uint32_t pin)
+__RAMFUNC void gpio_bit_reset(uint32_t gpio_periph, uint32_t pin)
 {
     GPIO_BC(gpio_periph) = (uint32_t) pin;
 }
@@ -32,6 +32,8 @@ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSI
 OF SUCH DAMAGE.
 */
 
+/* the umbrella header first: diy_gd32vf103_clkgate.h uses rcu_periph_enum */
+#include "gd32vf103.h"
 #include "gd32vf103_rcu.h"
 
 /* define clock source */
@@ -67,6 +69,7 @@ void rcu_deinit(void)
     RCU_INT = 0x00ff0000U;
     RCU_CFG1 &= ~(RCU_CFG1_PREDV0 | RCU_CFG1_PREDV1 | RCU_CFG1_PLL1MF | RCU_CFG1_PLL2MF |
                   RCU_CFG1_PREDV0SEL | RCU_CFG1_I2S1SEL | RCU_CFG1_I2S2SEL);
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -249,6 +252,7 @@ void rcu_system_clock_source_config(uint32_t ck_sys)
     /* reset the SCS bits and set according to ck_sys */
     reg &= ~RCU_CFG0_SCS;
     RCU_CFG0 = (reg | ck_sys);
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -282,6 +286,7 @@ void rcu_ahb_clock_config(uint32_t ck_ahb)
     /* reset the AHBPSC bits and set according to ck_ahb */
     reg &= ~RCU_CFG0_AHBPSC;
     RCU_CFG0 = (reg | ck_ahb);
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -305,6 +310,7 @@ void rcu_apb1_clock_config(uint32_t ck_apb1)
     /* reset the APB1PSC and set according to ck_apb1 */
     reg &= ~RCU_CFG0_APB1PSC;
     RCU_CFG0 = (reg | ck_apb1);
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -328,6 +334,7 @@ void rcu_apb2_clock_config(uint32_t ck_apb2)
     /* reset the APB2PSC and set according to ck_apb2 */
     reg &= ~RCU_CFG0_APB2PSC;
     RCU_CFG0 = (reg | ck_apb2);
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -380,6 +387,7 @@ void rcu_pll_config(uint32_t pll_src, uint32_t pll_mul)
     reg |= (pll_src | pll_mul);
 
     RCU_CFG0 = reg;
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -405,6 +413,7 @@ void rcu_predv0_config(uint32_t predv0_source, uint32_t predv0_div)
     reg |= (predv0_source | predv0_div);
 
     RCU_CFG1 = reg;
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -426,6 +435,7 @@ void rcu_predv1_config(uint32_t predv1_div)
     reg |= predv1_div;
 
     RCU_CFG1 = reg;
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -440,6 +450,7 @@ void rcu_pll1_config(uint32_t pll_mul)
 {
     RCU_CFG1 &= ~RCU_CFG1_PLL1MF;
     RCU_CFG1 |= pll_mul;
+    rcu_clock_cache_invalidate();
 }
 
 /*!
@@ -991,35 +1002,59 @@ void rcu_deepsleep_voltage_set(uint32_t dsvol)
     RCU_DSV = dsvol;
 }
 
+/* clock tree model: CK_SYS, CK_AHB, CK_APB1, CK_APB2, decoded once and cached; every
+   invalidation bumps the generation, the cache is valid while it holds the current one */
+static uint32_t rcu_clock_cache[CK_APB2 + 1U];
+static volatile uint32_t rcu_clock_cache_gen = 1U;
+static volatile uint32_t rcu_clock_cache_valid_gen = 0U;
+
+/* exponent of AHB, APB1 and APB2 clock divider */
+static const uint8_t ahb_exp[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 6, 7, 8, 9};
+static const uint8_t apb1_exp[8] = {0, 0, 0, 0, 1, 2, 3, 4};
+static const uint8_t apb2_exp[8] = {0, 0, 0, 0, 1, 2, 3, 4};
+
 /*!
-    \brief      get the system clock, bus and peripheral clock frequency
-    \param[in]  clock: the clock frequency which to get
-                only one parameter can be selected which is shown as below:
-      \arg        CK_SYS: system clock frequency
-      \arg        CK_AHB: AHB clock frequency
-      \arg        CK_APB1: APB1 clock frequency
-      \arg        CK_APB2: APB2 clock frequency
+    \brief      PLL output frequency for a PLL input and the PLLMF bits of RCU_CFG0
+    \param[in]  ck_src: PLL input frequency (IRC8M/2 or the PREDV0 output)
+    \param[in]  cfg0: RCU_CFG0 value, only PLLMF and PLLMF_4 are used
     \param[out] none
-    \retval     clock frequency of system, AHB, APB1, APB2
+    \retval     PLL output frequency
 */
-uint32_t rcu_clock_freq_get(rcu_clock_freq_enum clock)
+uint32_t rcu_pll_output(uint32_t ck_src, uint32_t cfg0)
 {
-    uint32_t sws, ck_freq = 0U;
-    uint32_t cksys_freq, ahb_freq, apb1_freq, apb2_freq;
-    uint32_t pllsel, predv0sel, pllmf,ck_src, idx, clk_exp;
-    uint32_t predv0, predv1, pll1mf;
-
-    /* exponent of AHB, APB1 and APB2 clock divider */
-    uint8_t ahb_exp[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 6, 7, 8, 9};
-    uint8_t apb1_exp[8] = {0, 0, 0, 0, 1, 2, 3, 4};
-    uint8_t apb2_exp[8] = {0, 0, 0, 0, 1, 2, 3, 4};
-
-    sws = GET_BITS(RCU_CFG0, 2, 3);
-    switch(sws){
-    /* IRC8M is selected as CK_SYS */
-    case SEL_IRC8M:
-        cksys_freq = IRC8M_VALUE;
-        break;
+    uint32_t pllmf;
+
+    /* PLL multiplication factor */
+    pllmf = GET_BITS(cfg0, 18, 21);
+    if((cfg0 & RCU_CFG0_PLLMF_4)){
+        pllmf |= 0x10U;
+    }
+    if(pllmf < 15U){
+        pllmf += 2U;
+    }else{
+        pllmf += 1U;
+    }
+
+    if(15U == pllmf){
+        /* PLL source clock multiply by 6.5 */
+        return ck_src * 6U + ck_src / 2U;
+    }
+    return ck_src * pllmf;
+}
+
+/*!
+    \brief      decode a clock tree from register values, touches no hardware
+    \param[in]  cfg0: RCU_CFG0 value, CK_SYS follows SCSS (the source actually in use)
+    \param[in]  cfg1: RCU_CFG1 value
+    \param[out] freq: CK_SYS, CK_AHB, CK_APB1 and CK_APB2 in Hz, indexed by rcu_clock_freq_enum
+    \retval     none
+*/
+void rcu_clock_tree_decode(uint32_t cfg0, uint32_t cfg1, uint32_t freq[CK_APB2 + 1U])
+{
+    uint32_t cksys_freq, ahb_freq;
+    uint32_t ck_src, predv0, predv1, pll1mf;
+
+    switch(GET_BITS(cfg0, 2, 3)){
     /* HXTAL is selected as CK_SYS */
     case SEL_HXTAL:
         cksys_freq = HXTAL_VALUE;
@@ -1027,47 +1062,27 @@ uint32_t rcu_clock_freq_get(rcu_clock_freq_enum clock)
     /* PLL is selected as CK_SYS */
     case SEL_PLL:
         /* PLL clock source selection, HXTAL or IRC8M/2 */
-        pllsel = (RCU_CFG0 & RCU_CFG0_PLLSEL);
-
-        if(RCU_PLLSRC_HXTAL == pllsel) {
+        if(RCU_PLLSRC_HXTAL == (cfg0 & RCU_CFG0_PLLSEL)){
             /* PLL clock source is HXTAL */
             ck_src = HXTAL_VALUE;
 
-            predv0sel = (RCU_CFG1 & RCU_CFG1_PREDV0SEL);
             /* source clock use PLL1 */
-            if(RCU_PREDV0SRC_CKPLL1 == predv0sel){
-                predv1 = (uint32_t)((RCU_CFG1 & RCU_CFG1_PREDV1) >> 4) + 1U;
-                pll1mf = (uint32_t)((RCU_CFG1 & RCU_CFG1_PLL1MF) >> 8) + 2U;
+            if(RCU_PREDV0SRC_CKPLL1 == (cfg1 & RCU_CFG1_PREDV0SEL)){
+                predv1 = (uint32_t)((cfg1 & RCU_CFG1_PREDV1) >> 4) + 1U;
+                pll1mf = (uint32_t)((cfg1 & RCU_CFG1_PLL1MF) >> 8) + 2U;
                 if(17U == pll1mf){
                     pll1mf = 20U;
                 }
                 ck_src = (ck_src / predv1) * pll1mf;
             }
-            predv0 = (RCU_CFG1 & RCU_CFG1_PREDV0) + 1U;
+            predv0 = (cfg1 & RCU_CFG1_PREDV0) + 1U;
             ck_src /= predv0;
         }else{
             /* PLL clock source is IRC8M/2 */
             ck_src = IRC8M_VALUE/2U;
         }
 
-        /* PLL multiplication factor */
-        pllmf = GET_BITS(RCU_CFG0, 18, 21);
-        if((RCU_CFG0 & RCU_CFG0_PLLMF_4)){
-            pllmf |= 0x10U;
-        }
-        if(pllmf < 15U){
-            pllmf += 2U;
-        }else{
-            pllmf += 1U;
-        }
-
-        cksys_freq = ck_src * pllmf;
-
-        if(15U == pllmf){
-            /* PLL source clock multiply by 6.5 */
-            cksys_freq = ck_src * 6U + ck_src / 2U;
-        }
-
+        cksys_freq = rcu_pll_output(ck_src, cfg0);
         break;
     /* IRC8M is selected as CK_SYS */
     default:
@@ -1075,37 +1090,76 @@ uint32_t rcu_clock_freq_get(rcu_clock_freq_enum clock)
         break;
     }
 
-    /* calculate AHB clock frequency */
-    idx = GET_BITS(RCU_CFG0, 4, 7);
-    clk_exp = ahb_exp[idx];
-    ahb_freq = cksys_freq >> clk_exp;
-    
-    /* calculate APB1 clock frequency */
-    idx = GET_BITS(RCU_CFG0, 8, 10);
-    clk_exp = apb1_exp[idx];
-    apb1_freq = ahb_freq >> clk_exp;
-    
-    /* calculate APB2 clock frequency */
-    idx = GET_BITS(RCU_CFG0, 11, 13);
-    clk_exp = apb2_exp[idx];
-    apb2_freq = ahb_freq >> clk_exp;
-    
-    /* return the clocks frequency */
-    switch(clock){
-    case CK_SYS:
-        ck_freq = cksys_freq;
-        break;
-    case CK_AHB:
-        ck_freq = ahb_freq;
-        break;
-    case CK_APB1:
-        ck_freq = apb1_freq;
-        break;
-    case CK_APB2:
-        ck_freq = apb2_freq;
-        break;
-    default:
-        break;
+    ahb_freq = cksys_freq >> ahb_exp[GET_BITS(cfg0, 4, 7)];
+    freq[CK_SYS] = cksys_freq;
+    freq[CK_AHB] = ahb_freq;
+    freq[CK_APB1] = ahb_freq >> apb1_exp[GET_BITS(cfg0, 8, 10)];
+    freq[CK_APB2] = ahb_freq >> apb2_exp[GET_BITS(cfg0, 11, 13)];
+}
+
+/*!
+    \brief      decode RCU_CFG0/RCU_CFG1 into the clock tree cache
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void rcu_clock_cache_update(void)
+{
+    uint32_t freq[CK_APB2 + 1U];
+    uint32_t gen, cfg0, irq, done;
+
+    do{
+        /* generation first: a setter interrupting the decode leaves it behind, decode again */
+        gen = rcu_clock_cache_gen;
+        cfg0 = RCU_CFG0;
+        rcu_clock_tree_decode(cfg0, RCU_CFG1, freq);
+
+        irq = diy_irq_save();
+        done = (gen == rcu_clock_cache_gen) ? 1U : 0U;
+        if(done){
+            rcu_clock_cache[CK_SYS] = freq[CK_SYS];
+            rcu_clock_cache[CK_AHB] = freq[CK_AHB];
+            rcu_clock_cache[CK_APB1] = freq[CK_APB1];
+            rcu_clock_cache[CK_APB2] = freq[CK_APB2];
+            /* a clock switch still in progress (SCSS != SCS) is decoded again next time */
+            if(GET_BITS(cfg0, 0, 1) == GET_BITS(cfg0, 2, 3)){
+                rcu_clock_cache_valid_gen = gen;
+            }
+        }
+        diy_irq_restore(irq);
+    }while(!done);
+}
+
+/*!
+    \brief      invalidate the cached clock tree, called by every RCU clock setter
+                (and by code that writes RCU_CFG0/RCU_CFG1 directly), also from interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void rcu_clock_cache_invalidate(void)
+{
+    rcu_clock_cache_gen++;
+}
+
+/*!
+    \brief      get the system clock, bus and peripheral clock frequency
+    \param[in]  clock: the clock frequency which to get
+                only one parameter can be selected which is shown as below:
+      \arg        CK_SYS: system clock frequency
+      \arg        CK_AHB: AHB clock frequency
+      \arg        CK_APB1: APB1 clock frequency
+      \arg        CK_APB2: APB2 clock frequency
+    \param[out] none
+    \retval     clock frequency of system, AHB, APB1, APB2
+*/
+uint32_t rcu_clock_freq_get(rcu_clock_freq_enum clock)
+{
+    if(clock > CK_APB2){
+        return 0U;
     }
-    return ck_freq;
-}
\ No newline at end of file
+    if(rcu_clock_cache_valid_gen != rcu_clock_cache_gen){
+        rcu_clock_cache_update();
+    }
+    return rcu_clock_cache[clock];
+}
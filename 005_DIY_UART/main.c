@@ -7,16 +7,20 @@
 #include "gd32vf103.h"
 
 // ====================================================================
-// LED Pin Definitions
+// Pin Definitions
 // ====================================================================
-#define LED_GREEN_PORT      GPIOA
-#define LED_GREEN_PIN       GPIO_PIN_1
+// All pins come from the board pin map (diy_gd32vf103_board.h), used as
+// DIY_BOARD_PIN(LED_RED) with the DIY_PIN_* macros (single constant-address stores).
+// The LEDs light when driven low, the key K1 reads high while pressed.
 
-#define LED_BLUE_PORT       GPIOA  
-#define LED_BLUE_PIN        GPIO_PIN_2
+// Addressable LED strip on DIY_BOARD_PIN(STRIP) (WS2812B, GRB byte order)
+#define STRIP_LEDS          8U
 
-#define LED_RED_PORT        GPIOC
-#define LED_RED_PIN         GPIO_PIN_13
+// Logic capture of the key and the green/blue LEDs (PA0..PA2), 2 s at 100 kHz
+#define LOGIC_PORT          DIY_PIN_PORT(DIY_BOARD_PIN(KEY))
+#define LOGIC_MASK          0x0007U
+#define LOGIC_RATE_HZ       100000U
+#define LOGIC_SAMPLES       200000U
 
 // ====================================================================
 // Serial Command Buffer
@@ -66,28 +70,68 @@ typedef struct {
 
 led_state_t current_led_state = {0, 0, 0, 0};
 
+// LED state kept across warm resets
+typedef struct {
+    diy_retain_header_t header;
+    led_state_t leds;
+} led_retain_t;
+
+#define LED_RETAIN_MAGIC 0x3044454CU  // "LED0"
+
+static __NOINIT led_retain_t led_retain;
+
+// One strip frame, stays valid while a DMA stream reads it
+static uint8_t strip_frame[STRIP_LEDS * 3U];
+
 // ====================================================================
 // Function Prototypes
 // ====================================================================
 void setup_usart0(void);
-void led_init(void);
+void setup_interrupts(void);
 void delay_cycles(uint32_t cycles);
 void process_serial_command(char* command);
 void set_led_red(uint8_t state);
 void set_led_green(uint8_t state);
 void set_led_blue(uint8_t state);
+void set_led_color(uint8_t red, uint8_t green, uint8_t blue);
+void setup_key(void);
+void handle_key_events(void);
+void setup_strip(void);
+void strip_show(void);
+void logic_capture(void);
 void send_led_status(char* color, uint8_t state);
 void rainbow_cycle(void);
+void check_stack_guard(void);
+void send_memory_report(void);
+void led_state_restore(void);
+void led_state_save(void);
+void send_reset_report(void);
+void change_clock(uint32_t hz);
+void send_clock_report(void);
+void send_irctrim_report(void);
 
 // ====================================================================
 // Main Function
 // ====================================================================
 int main(void) {
-    
+    DIY_BOOT_TIME_MARK_MAIN();
+
     // Initialize system
     SystemInit();
+    DIY_BOOT_TIME_MARK_CLOCK();
+    // Validate retained RAM before anything else touches it
+    diy_retain_init();
+    // Clocks, levels and modes of every pin in the board pin map, one pass
+    diy_board_init();
     setup_usart0();
-    led_init();
+    // Report (and clear) the record of a crash that caused the last reset
+    diy_crash_report();
+    led_state_restore();
+    // Drivers that depend on the core clock follow diy_clock_set() (and the fast-boot switch)
+    diy_clock_notifier_add(diy_usart_clock_notify);
+    diy_clock_notifier_add(diy_systick_clock_notify);
+    diy_clock_notifier_add(diy_irctrim_clock_notify);
+    setup_interrupts();
 
     // Send welcome message
     diy_usart_send_string("=== RGB LED Control via Serial ===\r\n");
@@ -98,9 +142,26 @@ int main(void) {
     diy_usart_send_string("  !off     - Turn off all LEDs\r\n");
     diy_usart_send_string("  !status  - Show current LED status\r\n");
     diy_usart_send_string("  !rainbows - Activate rainbow mode\r\n");
+    diy_usart_send_string("  !bench   - Run cycle benchmarks\r\n");
+    diy_usart_send_string("  !mem     - Show stack and heap usage\r\n");
+    diy_usart_send_string("  !reset   - Show reset cause and retained counters\r\n");
+    diy_usart_send_string("  !reboot  - Software reset (LED state is kept)\r\n");
+    diy_usart_send_string("  !boot    - Show startup phase timing\r\n");
+    diy_usart_send_string("  !slow    - Core clock 8 MHz (IRC8M)\r\n");
+    diy_usart_send_string("  !fast    - Core clock 108 MHz (PLL)\r\n");
+    diy_usart_send_string("  !clock   - Show core clock, IRC8M trim and clock faults\r\n");
+    diy_usart_send_string("  !gates   - Show peripheral clock users and on-time\r\n");
+    diy_usart_send_string("  !strip   - Show the LED colour on the WS2812 strip\r\n");
+    diy_usart_send_string("  !logic   - Capture PA0..PA2 and stream it run-length coded\r\n");
     diy_usart_send_string("Ready to receive commands...\r\n\r\n");
 
     while (1) {
+        // Report a stack overflow caught by the tick
+        check_stack_guard();
+
+        // Key presses queued by the debouncer
+        handle_key_events();
+
         // Si modo rainbow está activo, ejecutar ciclo
         if (current_led_state.rainbow_mode) {
             rainbow_cycle();
@@ -122,6 +183,7 @@ int main(void) {
                 // Process the command
                 if (buffer_index > 0) {
                     process_serial_command(serial_buffer);
+                    led_state_save();
                 }
                 
                 // Reset buffer
@@ -149,12 +211,7 @@ int main(void) {
 // USART Setup Function
 // ====================================================================
 void setup_usart0(void) {
-    rcu_periph_clock_enable(RCU_GPIOA);
-    rcu_periph_clock_enable(RCU_USART0);
-
-    gpio_init(GPIOA, GPIO_MODE_AF_PP, GPIO_OSPEED_50MHZ, GPIO_PIN_9);
-    gpio_init(GPIOA, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, GPIO_PIN_10);
-    
+    // TX/RX pins and the USART0 clock are set up by diy_board_init()
     diy_usart_deinit(USART0);
 
     diy_usart_config_t usart_config = {
@@ -173,22 +230,114 @@ void setup_usart0(void) {
 }
 
 // ====================================================================
-// LED Initialization Function
+// Interrupt Setup Function
 // ====================================================================
-void led_init(void) {
-    // Enable GPIO clocks
-    rcu_periph_clock_enable(RCU_GPIOA);
-    rcu_periph_clock_enable(RCU_GPIOC);
-    
-    // Configure GPIO pins
-    gpio_init(LED_GREEN_PORT, GPIO_MODE_OUT_PP, GPIO_OSPEED_2MHZ, LED_GREEN_PIN);
-    gpio_init(LED_BLUE_PORT, GPIO_MODE_OUT_PP, GPIO_OSPEED_2MHZ, LED_BLUE_PIN);
-    gpio_init(LED_RED_PORT, GPIO_MODE_OUT_PP, GPIO_OSPEED_2MHZ, LED_RED_PIN);
-    
-    // Initialize all LEDs OFF (High = OFF for common cathode)
-    gpio_bit_set(LED_GREEN_PORT, LED_GREEN_PIN);   // Green OFF
-    gpio_bit_set(LED_BLUE_PORT, LED_BLUE_PIN);     // Blue OFF  
-    gpio_bit_set(LED_RED_PORT, LED_RED_PIN);       // Red OFF
+void setup_interrupts(void) {
+    diy_eclic_init();
+    diy_eclic_priority_group_set(ECLIC_PRIGROUP_LEVEL3_PRIO1);
+    diy_eclic_threshold_set(0);
+
+    // 1 kHz tick, checks the stack guard words
+    diy_systick_init(1000);
+    diy_systick_hook_add(diy_stack_guard_tick);
+    // Clock monitor recovery; FAST_BOOT=1: the PLL is still locking, switch to it from the RCU interrupt
+    diy_clock_irq_enable();
+    // Keep IRC8M on frequency against the 32.768 kHz crystal
+    diy_irctrim_init();
+    // Debounced key events through EXTI, nothing is polled
+    setup_key();
+    // WS2812 strip, its DMA refill interrupt has to be routed here
+    setup_strip();
+
+    diy_eclic_global_interrupt_enable();
+}
+
+// ====================================================================
+// Key Functions
+// ====================================================================
+void setup_key(void) {
+    // pull-down input, configured by diy_board_init()
+    diy_button_add(DIY_PIN_PORT(DIY_BOARD_PIN(KEY)), DIY_BOARD_LINE(KEY), 1);
+}
+
+// Press toggles rainbow mode, holding the key turns everything off
+void handle_key_events(void) {
+    diy_button_event_t key = diy_button_event_get();
+    // process_serial_command() lower-cases in place, so pass writable copies
+    char rainbows[] = "!rainbows";
+    char off[] = "!off";
+
+    if (DIY_BUTTON_EVENT_PRESS == key.event) {
+        process_serial_command(rainbows);
+        led_state_save();
+    }
+    else if (DIY_BUTTON_EVENT_LONG_PRESS == key.event) {
+        process_serial_command(off);
+        led_state_save();
+    }
+}
+
+// ====================================================================
+// LED Strip Functions
+// ====================================================================
+void setup_strip(void) {
+    static const diy_ws2812_timing_t strip_timing = DIY_WS2812_TIMING_WS2812B;
+
+    diy_ws2812_init(DIY_BOARD_PIN(STRIP), &strip_timing);
+}
+
+// Fill the strip with the current colour, fading out along it: once bit-banged,
+// once through DMA, and report how long each kept the CPU
+void strip_show(void) {
+    uint32_t start, banged, streamed;
+
+    for (uint32_t i = 0; i < STRIP_LEDS; i++) {
+        uint8_t level = (uint8_t)(0x40U >> (i / 2U));
+
+        strip_frame[i * 3U + 0U] = current_led_state.green ? level : 0U;
+        strip_frame[i * 3U + 1U] = current_led_state.red ? level : 0U;
+        strip_frame[i * 3U + 2U] = current_led_state.blue ? level : 0U;
+    }
+
+    // at least 1 ms apart, so the latch wait of the previous frame is not timed
+    diy_systick_delay(2U);
+    start = diy_cycle_get();
+    if (ERROR == diy_ws2812_send(strip_frame, sizeof(strip_frame))) {
+        diy_usart_send_string("Strip: core clock too slow for WS2812 timing\r\n");
+        return;
+    }
+    banged = diy_cycle_get() - start;
+
+    diy_systick_delay(2U);
+    start = diy_cycle_get();
+    if (ERROR == diy_ws2812_stream(strip_frame, sizeof(strip_frame))) {
+        diy_usart_send_string("Strip: timer clock too slow for the DMA stream\r\n");
+        return;
+    }
+    streamed = diy_cycle_get() - start;
+    while (SET == diy_ws2812_busy()) {
+    }
+
+    diy_usart_send_string("Strip: ");
+    diy_usart_send_dec(STRIP_LEDS);
+    diy_usart_send_string(" LEDs, bit-bang ");
+    diy_usart_send_dec(banged);
+    diy_usart_send_string(" cycles (interrupts masked), DMA start ");
+    diy_usart_send_dec(streamed);
+    diy_usart_send_string(" cycles\r\n");
+}
+
+// ====================================================================
+// Logic Capture Function
+// ====================================================================
+// Sampling runs on TIMER2 + DMA, this loop only compresses and sends
+void logic_capture(void) {
+    if (ERROR == diy_logic_start(LOGIC_PORT, LOGIC_MASK, LOGIC_RATE_HZ, LOGIC_SAMPLES)) {
+        diy_usart_send_string("Logic: sample rate not reachable\r\n");
+        return;
+    }
+    while (DIY_LOGIC_RUNNING == diy_logic_poll()) {
+    }
 }
 
 // ====================================================================
@@ -232,9 +381,7 @@ void process_serial_command(char* command) {
         current_led_state.red = 0;
         current_led_state.green = 0;
         current_led_state.blue = 0;
-        set_led_red(0);
-        set_led_green(0);
-        set_led_blue(0);
+        set_led_color(0, 0, 0);
         diy_usart_send_string("All LEDs turned OFF\r\n");
     }
     else if (string_compare(command, "!rainbows") == 0) {
@@ -244,9 +391,7 @@ void process_serial_command(char* command) {
         } else {
             diy_usart_send_string("Rainbow mode OFF\r\n");
             // Apagar todos los LEDs al salir del modo rainbow
-            set_led_red(0);
-            set_led_green(0);
-            set_led_blue(0);
+            set_led_color(0, 0, 0);
             current_led_state.red = 0;
             current_led_state.green = 0;
             current_led_state.blue = 0;
@@ -262,11 +407,50 @@ void process_serial_command(char* command) {
             send_led_status((char*)"Blue", current_led_state.blue);
         }
     }
+    else if (string_compare(command, "!bench") == 0) {
+        uint32_t pin_count;
+        const gpio_init_parameter_struct *pins = diy_board_pins_get(&pin_count);
+
+        diy_bench_run();
+        diy_bench_gpio_init(pins, pin_count);
+    }
+    else if (string_compare(command, "!mem") == 0) {
+        send_memory_report();
+    }
+    else if (string_compare(command, "!reset") == 0) {
+        send_reset_report();
+    }
+    else if (string_compare(command, "!boot") == 0) {
+        diy_boot_time_report();
+    }
+    else if (string_compare(command, "!slow") == 0) {
+        change_clock(8000000);
+    }
+    else if (string_compare(command, "!fast") == 0) {
+        change_clock(108000000);
+    }
+    else if (string_compare(command, "!clock") == 0) {
+        send_clock_report();
+    }
+    else if (string_compare(command, "!gates") == 0) {
+        diy_clkgate_report();
+    }
+    else if (string_compare(command, "!strip") == 0) {
+        strip_show();
+    }
+    else if (string_compare(command, "!logic") == 0) {
+        logic_capture();
+    }
+    else if (string_compare(command, "!reboot") == 0) {
+        diy_usart_send_string("Rebooting...\r\n");
+        led_state_save();
+        diy_system_reset();
+    }
     else {
         diy_usart_send_string("Unknown command: ");
         diy_usart_send_string(command);
         diy_usart_send_string("\r\n");
-        diy_usart_send_string("Valid commands: !red, !green, !blue, !off, !status, !rainbows\r\n");
+        diy_usart_send_string("Valid commands: !red, !green, !blue, !off, !status, !rainbows, !bench, !mem, !reset, !reboot, !boot, !slow, !fast, !clock, !gates, !strip, !logic\r\n");
     }
 }
 
@@ -274,27 +458,31 @@ void process_serial_command(char* command) {
 // LED Control Functions
 // ====================================================================
 void set_led_red(uint8_t state) {
-    if (state) {
-        gpio_bit_reset(LED_RED_PORT, LED_RED_PIN);  // Turn ON (Low = ON)
-    } else {
-        gpio_bit_set(LED_RED_PORT, LED_RED_PIN);    // Turn OFF (High = OFF)
-    }
+    // Low = ON, High = OFF
+    DIY_PIN_WRITE(DIY_BOARD_PIN(LED_RED), !state);
 }
 
 void set_led_green(uint8_t state) {
-    if (state) {
-        gpio_bit_reset(LED_GREEN_PORT, LED_GREEN_PIN);  // Turn ON
-    } else {
-        gpio_bit_set(LED_GREEN_PORT, LED_GREEN_PIN);    // Turn OFF
-    }
+    // Low = ON, High = OFF
+    DIY_PIN_WRITE(DIY_BOARD_PIN(LED_GREEN), !state);
 }
 
 void set_led_blue(uint8_t state) {
-    if (state) {
-        gpio_bit_reset(LED_BLUE_PORT, LED_BLUE_PIN);  // Turn ON
-    } else {
-        gpio_bit_set(LED_BLUE_PORT, LED_BLUE_PIN);    // Turn OFF
-    }
+    // Low = ON, High = OFF
+    DIY_PIN_WRITE(DIY_BOARD_PIN(LED_BLUE), !state);
+}
+
+// All three LEDs at once: one BOP store per port, so no in-between colour is shown
+void set_led_color(uint8_t red, uint8_t green, uint8_t blue) {
+    uint32_t bop_green_blue = DIY_PIN_BOP_BITS(DIY_BOARD_PIN(LED_GREEN), !green) |
+                              DIY_PIN_BOP_BITS(DIY_BOARD_PIN(LED_BLUE), !blue);
+    uint32_t bop_red = DIY_PIN_BOP_BITS(DIY_BOARD_PIN(LED_RED), !red);
+
+    // Green and blue share GPIOA (PA1/PA2), red is alone on GPIOC
+    _Static_assert(DIY_PIN_PORT(DIY_BOARD_PIN(LED_GREEN)) == DIY_PIN_PORT(DIY_BOARD_PIN(LED_BLUE)),
+                   "set_led_color() writes green and blue together");
+    GPIO_BOP(DIY_PIN_PORT(DIY_BOARD_PIN(LED_GREEN))) = bop_green_blue;
+    GPIO_BOP(DIY_PIN_PORT(DIY_BOARD_PIN(LED_RED))) = bop_red;
 }
 
 // ====================================================================
@@ -311,6 +499,135 @@ void send_led_status(char* color, uint8_t state) {
     diy_usart_send_string("\r\n");
 }
 
+// ====================================================================
+// Retained State Functions
+// ====================================================================
+void led_state_restore(void) {
+    if (ERROR == diy_retain_check(&led_retain.header, sizeof(led_retain), LED_RETAIN_MAGIC)) {
+        return;
+    }
+
+    // Warm reset: resume with the LEDs as they were
+    current_led_state = led_retain.leds;
+    set_led_color(current_led_state.red, current_led_state.green, current_led_state.blue);
+}
+
+void led_state_save(void) {
+    led_retain.leds = current_led_state;
+    diy_retain_commit(&led_retain.header, sizeof(led_retain), LED_RETAIN_MAGIC);
+}
+
+void send_reset_report(void) {
+    diy_retain_sys_t *sys = diy_retain_sys_get();
+
+    diy_usart_send_string("Reset cause: ");
+    diy_usart_send_string(diy_reset_cause_name(diy_reset_cause_get()));
+    diy_usart_send_string((SUCCESS == diy_retain_warm_get()) ? " (warm)\r\n" : " (cold)\r\n");
+    diy_usart_send_string("Boots: ");
+    diy_usart_send_dec(sys->boot_count);
+    diy_usart_send_string(", warm: ");
+    diy_usart_send_dec(sys->warm_count);
+    diy_usart_send_string("\r\nLog:");
+    for (uint32_t i = 0; i < DIY_RETAIN_LOG_SIZE; i++) {
+        diy_usart_send_string(" ");
+        diy_usart_send_hex(sys->log[(sys->log_index + i) % DIY_RETAIN_LOG_SIZE]);
+    }
+    diy_usart_send_string("\r\n");
+}
+
+// ====================================================================
+// Clock Functions
+// ====================================================================
+void change_clock(uint32_t hz) {
+    if (SUCCESS != diy_clock_set(hz)) {
+        diy_usart_send_string("Clock change failed, ");
+    }
+    // USART0 was re-timed by its notifier, so this arrives at the same baud rate
+    diy_usart_send_string("Core clock: ");
+    diy_usart_send_dec(diy_clock_get());
+    diy_usart_send_string(" Hz\r\n");
+}
+
+void send_clock_report(void) {
+    const diy_clock_status_t *status = diy_clock_status_get();
+
+    diy_usart_send_string("Core clock: ");
+    diy_usart_send_dec(diy_clock_get());
+    diy_usart_send_string(" Hz, APB1 ");
+    diy_usart_send_dec(rcu_clock_freq_get(CK_APB1));
+    diy_usart_send_string(" Hz, APB2 ");
+    diy_usart_send_dec(rcu_clock_freq_get(CK_APB2));
+    diy_usart_send_string(" Hz\r\n");
+    if (SET == diy_clock_async_pending()) {
+        diy_usart_send_string("Fast boot: PLL not locked yet\r\n");
+    }
+    send_irctrim_report();
+    diy_usart_send_string("HXTAL failures: ");
+    diy_usart_send_dec(status->hxtal_failures);
+    diy_usart_send_string(", stuck: ");
+    diy_usart_send_dec(status->hxtal_stuck);
+    diy_usart_send_string(", PLL lock: ");
+    diy_usart_send_dec(status->pll_failures);
+    diy_usart_send_string(", switch: ");
+    diy_usart_send_dec(status->switch_failures);
+    if (0 != status->last_code) {
+        diy_usart_send_string(", last ");
+        diy_usart_send_hex(status->last_code);
+        diy_usart_send_string(" at tick ");
+        diy_usart_send_dec(status->last_tick);
+    }
+    diy_usart_send_string("\r\n");
+}
+
+void send_irctrim_report(void) {
+    const diy_irctrim_status_t *trim = diy_irctrim_status_get();
+
+    diy_usart_send_string("IRC8M trim: ");
+    diy_usart_send_dec(trim->trim);
+    if (RESET == diy_irctrim_lxtal_ready()) {
+        diy_usart_send_string(" (LXTAL not running)\r\n");
+        return;
+    }
+    diy_usart_send_string(", last error ");
+    if (trim->error_ppm < 0) {
+        diy_usart_send_byte('-');
+    }
+    diy_usart_send_dec((trim->error_ppm < 0) ? -trim->error_ppm : trim->error_ppm);
+    diy_usart_send_string(" ppm, ");
+    diy_usart_send_dec(trim->windows);
+    diy_usart_send_string(" measurements, ");
+    diy_usart_send_dec(trim->adjustments);
+    diy_usart_send_string(" steps\r\n");
+}
+
+// ====================================================================
+// Memory Reporting Functions
+// ====================================================================
+void check_stack_guard(void) {
+    static uint8_t reported = 0;
+
+    if ((ERROR == diy_stack_guard_status_get()) && !reported) {
+        reported = 1;
+        diy_usart_send_string("\r\nWARNING: stack guard overwritten!\r\n");
+    }
+}
+
+void send_memory_report(void) {
+    diy_usart_send_string("Stack: ");
+    diy_usart_send_dec(diy_stack_peak_get());
+    diy_usart_send_string(" / ");
+    diy_usart_send_dec(diy_stack_size_get());
+    diy_usart_send_string(" bytes peak (now ");
+    diy_usart_send_dec(diy_stack_used_get());
+    diy_usart_send_string(")\r\n");
+
+    diy_usart_send_string("Heap:  ");
+    diy_usart_send_dec(diy_heap_free_get());
+    diy_usart_send_string(" / ");
+    diy_usart_send_dec(diy_heap_size_get());
+    diy_usart_send_string(" bytes free\r\n");
+}
+
 // ====================================================================
 // Rainbow Effect Function
 // ====================================================================
@@ -329,34 +646,22 @@ void rainbow_cycle(void) {
     // Ciclo de colores del arcoíris
     switch (step) {
         case 0: // Rojo
-            set_led_red(1);
-            set_led_green(0);
-            set_led_blue(0);
+            set_led_color(1, 0, 0);
             break;
         case 1: // Amarillo (Rojo + Verde)
-            set_led_red(1);
-            set_led_green(1);
-            set_led_blue(0);
+            set_led_color(1, 1, 0);
             break;
         case 2: // Verde
-            set_led_red(0);
-            set_led_green(1);
-            set_led_blue(0);
+            set_led_color(0, 1, 0);
             break;
         case 3: // Cian (Verde + Azul)
-            set_led_red(0);
-            set_led_green(1);
-            set_led_blue(1);
+            set_led_color(0, 1, 1);
             break;
         case 4: // Azul
-            set_led_red(0);
-            set_led_green(0);
-            set_led_blue(1);
+            set_led_color(0, 0, 1);
             break;
         case 5: // Magenta (Rojo + Azul)
-            set_led_red(1);
-            set_led_green(0);
-            set_led_blue(1);
+            set_led_color(1, 0, 1);
             break;
     }
     
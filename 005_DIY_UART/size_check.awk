@@ -0,0 +1,59 @@
+# Compare size.txt (name value per line) against the limits and the baseline, if there is one.
+# Used by 'make size-check', see size_limits.mk.
+
+function under(name, value, limit) {
+    if (value < limit) {
+        printf("FAIL %-8s %7d < %7d\n", name, value, limit)
+        fail = 1
+    } else {
+        printf("ok   %-8s %7d >= %6d\n", name, value, limit)
+    }
+}
+
+function over(name, value, limit) {
+    if (value > limit) {
+        printf("FAIL %-8s %7d > %7d\n", name, value, limit)
+        fail = 1
+    } else {
+        printf("ok   %-8s %7d <= %6d\n", name, value, limit)
+    }
+}
+
+{ cur[$1] = $2 }
+
+END {
+    over("text", cur["text"], text_max)
+    over("data", cur["data"], data_max)
+    over("bss", cur["bss"], bss_max)
+
+    under("heap", cur["heap"], heap_min)
+    under("stack", cur["stack"], stack_min)
+
+    # '#' lines are comments; no baseline yet (none measured with the cross toolchain) skips
+    # the growth check
+    nbase = 0
+    while ((getline line < baseline) > 0) {
+        if (line !~ /^#/) {
+            split(line, f, " ")
+            base[f[1]] = f[2]
+            nbase++
+        }
+    }
+    if (nbase == 0) {
+        printf("note     no baseline in %s, growth not checked; run 'make size-baseline' and commit it\n", baseline)
+        exit fail
+    }
+
+    n = split("text data bss", names, " ")
+    for (i = 1; i <= n; i++) {
+        name = names[i]
+        if (!(name in base)) {
+            printf("FAIL %-8s not in %s, run 'make size-baseline' and commit it\n", name, baseline)
+            fail = 1
+        } else {
+            over(name " +", cur[name] - base[name], growth_max)
+        }
+    }
+
+    exit fail
+}
@@ -0,0 +1,12 @@
+# Memory budget for 'make size-check' (bytes).
+# FLASH is 128K and RAM is 32K, see gd32vf103xb.ld.
+
+# Absolute limits
+SIZE_TEXT_MAX = 98304       # .vector_table + .text (FLASH), 75% of FLASH
+SIZE_DATA_MAX = 2048        # .data + .ramfunc (RAM, load image in FLASH)
+SIZE_BSS_MAX = 8192         # .bss + .noinit (RAM)
+SIZE_HEAP_MIN = 8192        # RAM between _end and _heap_end, what diy_heap_reserve() can hand out
+SIZE_STACK_MIN = 1024       # RAM reserved for the stack, __stack_size in gd32vf103xb.ld
+
+# Allowed growth of text/data/bss over size_baseline.txt, 0 = any growth fails
+SIZE_GROWTH_MAX = 512
@@ -0,0 +1,128 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "gd32vf103.h"
+
+/* host test of diy_clock_solve(): every target from 0.25 MHz to DIY_CLOCK_SYS_MAX in 0.25 MHz
+   steps, from IRC8M and from HXTAL. A solution must decode back to its target through
+   rcu_clock_tree_decode() and keep every divider output inside the clock.h limits; a target
+   without a solution must also have none in a brute-force search of every PLL setting */
+
+#define SOLVE_STEP                    250000U
+
+static uint32_t solve_solved = 0U;
+static uint32_t solve_targets = 0U;
+static uint32_t solve_bad = 0U;
+
+static uint32_t solve_in_range(uint32_t hz, uint32_t min, uint32_t max)
+{
+    return (hz >= min) && (hz <= max);
+}
+
+/* CK_SYS of a configuration as the RCU reports it once SCSS follows SCS */
+static uint32_t solve_decode(uint32_t scs, uint32_t cfg0, uint32_t cfg1)
+{
+    uint32_t freq[CK_APB2 + 1U];
+
+    rcu_clock_tree_decode(cfg0 | (scs << 2), cfg1, freq);
+    return freq[CK_SYS];
+}
+
+/* the PLL input of a PLL configuration when every divider output is exact and in range, else 0 */
+static uint32_t solve_pll_in(uint32_t cfg0, uint32_t cfg1)
+{
+    uint32_t predv0 = GET_BITS(cfg1, 0, 3) + 1U;
+    uint32_t predv1 = GET_BITS(cfg1, 4, 7) + 1U;
+    uint32_t pll1mf = GET_BITS(cfg1, 8, 11);
+    uint32_t pll1_out;
+
+    if (0U == (cfg0 & RCU_CFG0_PLLSEL)) {
+        return IRC8M_VALUE / 2U;
+    }
+    if (0U == (cfg1 & RCU_CFG1_PREDV0SEL)) {
+        pll1_out = HXTAL_VALUE;
+    } else {
+        if ((pll1mf < 6U) || (0U != (HXTAL_VALUE % predv1)) ||
+            !solve_in_range(HXTAL_VALUE / predv1, DIY_CLOCK_PLL1_IN_MIN, DIY_CLOCK_PLL1_IN_MAX)) {
+            return 0U;
+        }
+        pll1_out = (HXTAL_VALUE / predv1) * ((15U == pll1mf) ? 20U : (pll1mf + 2U));
+        if (!solve_in_range(pll1_out, DIY_CLOCK_PLL1_OUT_MIN, DIY_CLOCK_PLL1_OUT_MAX)) {
+            return 0U;
+        }
+    }
+    if ((0U != (pll1_out % predv0)) ||
+        !solve_in_range(pll1_out / predv0, DIY_CLOCK_PLL_IN_MIN, DIY_CLOCK_PLL_IN_MAX)) {
+        return 0U;
+    }
+    return pll1_out / predv0;
+}
+
+/* a valid PLL setting that reaches target_hz, tried over every PLLMF/PREDV0/PREDV1/PLL1MF */
+static uint32_t solve_brute(uint32_t hxtal, uint32_t target_hz)
+{
+    for (uint32_t mf = 0U; mf < 32U; mf++) {
+        uint32_t cfg0 = CFG0_PLLMF(mf & 0x0FU) | ((mf & 0x10U) ? RCU_CFG0_PLLMF_4 : 0U);
+
+        if (0U == hxtal) {
+            if (rcu_pll_output(solve_pll_in(cfg0, 0U), cfg0) == target_hz) {
+                return 1U;
+            }
+            continue;
+        }
+        cfg0 |= RCU_CFG0_PLLSEL;
+        for (uint32_t cfg1 = 0U; cfg1 < 0x1000U; cfg1++) {
+            // PREDV1 and PLL1MF only matter with PREDV0SEL set (and PLL1MF 0 is reserved)
+            uint32_t sel = (cfg1 < 0x10U) ? 0U : RCU_CFG1_PREDV0SEL;
+            uint32_t pll_in = solve_pll_in(cfg0, cfg1 | sel);
+
+            if ((0U != pll_in) && (rcu_pll_output(pll_in, cfg0) == target_hz)) {
+                return 1U;
+            }
+        }
+    }
+    return 0U;
+}
+
+static void solve_check(uint32_t hxtal, uint32_t target_hz)
+{
+    diy_clock_config_t config;
+    uint32_t direct = hxtal ? HXTAL_VALUE : IRC8M_VALUE;
+    uint32_t got;
+
+    solve_targets++;
+    if (SUCCESS != diy_clock_solve(hxtal ? DIY_CLOCK_SRC_HXTAL : DIY_CLOCK_SRC_IRC8M, target_hz, &config)) {
+        if ((target_hz == direct) || solve_brute(hxtal, target_hz)) {
+            printf("MISSED %s %u Hz\n", hxtal ? "HXTAL" : "IRC8M", target_hz);
+            solve_bad++;
+        }
+        return;
+    }
+    solve_solved++;
+
+    got = solve_decode(config.scs, config.cfg0, config.cfg1);
+    if ((got != target_hz) || (config.hz != target_hz) ||
+        ((RCU_CKSYSSRC_PLL == config.scs) &&
+         ((0U == solve_pll_in(config.cfg0, config.cfg1)) || (!!(config.cfg0 & RCU_CFG0_PLLSEL) != hxtal))) ||
+        ((RCU_CKSYSSRC_PLL != config.scs) && (got != direct))) {
+        printf("BAD %s %u Hz: scs %u cfg0 %08x cfg1 %08x decodes to %u\n", hxtal ? "HXTAL" : "IRC8M",
+               target_hz, config.scs, config.cfg0, config.cfg1, got);
+        solve_bad++;
+    }
+}
+
+int main(void)
+{
+    for (uint32_t hxtal = 0U; hxtal < 2U; hxtal++) {
+        for (uint32_t target_hz = SOLVE_STEP; target_hz <= DIY_CLOCK_SYS_MAX; target_hz += SOLVE_STEP) {
+            solve_check(hxtal, target_hz);
+        }
+        // the crystal itself, when it is off the 0.25 MHz grid
+        if (hxtal && (0U != (HXTAL_VALUE % SOLVE_STEP))) {
+            solve_check(hxtal, HXTAL_VALUE);
+        }
+    }
+
+    printf("clock solver, HXTAL %u Hz: %u targets, %u solved, %u bad\n",
+           HXTAL_VALUE, solve_targets, solve_solved, solve_bad);
+    return (0U == solve_bad) ? 0 : 1;
+}
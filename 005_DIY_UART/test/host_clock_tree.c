@@ -0,0 +1,200 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "gd32vf103.h"
+
+/* host test of rcu_clock_tree_decode(): every SCS/SCSS, AHB/APB1/APB2 prescaler and PLL
+   field is run through the RCU decode and through the model below, which is written from
+   the RCU chapter of the GD32VF103 user manual instead of from the decode */
+
+/* PLLMF[4:0] in half steps: x2..x14, x6.5, x16, x16, x17..x32 */
+static const uint8_t model_pllmf_half[32] = {
+     4,  6,  8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 13, 32, 32,
+    34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64,
+};
+/* PLL1MF[3:0], 0 = reserved: x8..x16, x20 */
+static const uint8_t model_pll1mf[16] = {
+    0, 0, 0, 0, 0, 0, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20,
+};
+static const uint16_t model_ahb_div[16] = {1, 1, 1, 1, 1, 1, 1, 1, 2, 4, 8, 16, 64, 128, 256, 512};
+static const uint8_t model_apb_div[8] = {1, 1, 1, 1, 2, 4, 8, 16};
+
+/* CFG0 bits the decode must not look at: USBFSPSC, CKOUT0SEL, ADCPSC */
+#define TREE_CFG0_NOISE               (BITS(14,15) | BIT(22) | BITS(24,27) | BIT(28))
+
+/* one setting of the fields the decode reads */
+typedef struct {
+    uint32_t scs;
+    uint32_t scss;
+    uint32_t ahb;
+    uint32_t apb1;
+    uint32_t apb2;
+    uint32_t pllsel;
+    uint32_t pllmf;
+    uint32_t predv0sel;
+    uint32_t predv0;
+    uint32_t predv1;
+    uint32_t pll1mf;
+}tree_fields_t;
+
+static uint32_t tree_checked = 0U;
+static uint32_t tree_rounded = 0U;
+static uint32_t tree_skipped = 0U;
+static uint32_t tree_bad = 0U;
+
+/* CK_SYS as the fraction num / den Hz, 0 when a reserved PLL1MF is in use */
+static uint32_t model_cksys(const tree_fields_t *f, uint64_t *num, uint64_t *den)
+{
+    switch (f->scss) {
+    case 1U:
+        *num = HXTAL_VALUE;
+        *den = 1U;
+        return 1U;
+    case 2U:
+        break;
+    default:
+        // 3 is reserved, the decode falls back to IRC8M like the reset state
+        *num = IRC8M_VALUE;
+        *den = 1U;
+        return 1U;
+    }
+
+    if (0U == f->pllsel) {
+        *num = IRC8M_VALUE;
+        *den = 2U;
+    } else if (0U == f->predv0sel) {
+        *num = HXTAL_VALUE;
+        *den = f->predv0 + 1U;
+    } else {
+        if (0U == model_pll1mf[f->pll1mf]) {
+            return 0U;
+        }
+        *num = (uint64_t)HXTAL_VALUE * model_pll1mf[f->pll1mf];
+        *den = (uint64_t)(f->predv1 + 1U) * (f->predv0 + 1U);
+    }
+    *num *= model_pllmf_half[f->pllmf];
+    *den *= 2U;
+    return 1U;
+}
+
+/* the hardware divides without remainders when every divider output is a whole number of Hz */
+static uint32_t model_exact(const tree_fields_t *f)
+{
+    uint64_t pll1_out;
+
+    if ((2U != f->scss) || (0U == f->pllsel)) {
+        return 1U;
+    }
+    if (0U == f->predv0sel) {
+        pll1_out = HXTAL_VALUE;
+    } else {
+        if (0U != (HXTAL_VALUE % (f->predv1 + 1U))) {
+            return 0U;
+        }
+        pll1_out = (uint64_t)(HXTAL_VALUE / (f->predv1 + 1U)) * model_pll1mf[f->pll1mf];
+    }
+    if (0U != (pll1_out % (f->predv0 + 1U))) {
+        return 0U;
+    }
+    // x6.5 needs an even PLL input
+    return (13U != model_pllmf_half[f->pllmf]) || (0U == ((pll1_out / (f->predv0 + 1U)) % 2U));
+}
+
+static void tree_check(const tree_fields_t *f)
+{
+    uint32_t cfg0, cfg1;
+    uint32_t freq[CK_APB2 + 1U];
+    uint64_t num, den, sys, slack;
+    uint32_t bus_div[CK_APB2 + 1U];
+
+    if (0U == model_cksys(f, &num, &den)) {
+        tree_skipped++;
+        return;
+    }
+    // settings beyond 32 bits of Hz are far past DIY_CLOCK_SYS_MAX, the decode does not cover them
+    if ((num / den) > 0xFFFFFFFFU) {
+        tree_skipped++;
+        return;
+    }
+
+    cfg0 = f->scs | (f->scss << 2) | (f->ahb << 4) | (f->apb1 << 8) | (f->apb2 << 11) |
+           (f->pllsel ? RCU_CFG0_PLLSEL : 0U) | CFG0_PLLMF(f->pllmf & 0x0FU) |
+           ((f->pllmf & 0x10U) ? RCU_CFG0_PLLMF_4 : 0U) | TREE_CFG0_NOISE;
+    cfg1 = CFG1_PREDV0(f->predv0) | CFG1_PREDV1(f->predv1) | CFG1_PLL1MF(f->pll1mf) |
+           (f->predv0sel ? RCU_CFG1_PREDV0SEL : 0U);
+    rcu_clock_tree_decode(cfg0, cfg1, freq);
+
+    bus_div[CK_SYS] = 1U;
+    bus_div[CK_AHB] = model_ahb_div[f->ahb];
+    bus_div[CK_APB1] = model_ahb_div[f->ahb] * model_apb_div[f->apb1];
+    bus_div[CK_APB2] = model_ahb_div[f->ahb] * model_apb_div[f->apb2];
+
+    // a chain with remainders may round down once per divider: PREDV1 (times PLL1MF and PLLMF),
+    // PREDV0 (times PLLMF) and the half of x6.5, well under a kHz
+    sys = num / den;
+    slack = model_exact(f) ? 0U : (20U * 32U + 32U + 1U);
+    if (0U != slack) {
+        tree_rounded++;
+    }
+
+    for (uint32_t bus = CK_SYS; bus <= CK_APB2; bus++) {
+        uint64_t want = sys / bus_div[bus];
+
+        if ((freq[bus] > want) || ((want - freq[bus]) > slack)) {
+            if (tree_bad < 10U) {
+                printf("BAD cfg0 %08x cfg1 %08x bus %u: decode %u, model %llu\n",
+                       cfg0, cfg1, bus, freq[bus], (unsigned long long)want);
+            }
+            tree_bad++;
+            return;
+        }
+    }
+    tree_checked++;
+}
+
+int main(void)
+{
+    tree_fields_t f = {0};
+    uint32_t bus = 0U;
+
+    // without the PLL: every source and prescaler combination
+    for (f.scss = 0U; f.scss < 4U; f.scss++) {
+        if (2U == f.scss) {
+            continue;
+        }
+        for (f.scs = 0U; f.scs < 4U; f.scs++) {
+            for (f.ahb = 0U; f.ahb < 16U; f.ahb++) {
+                for (f.apb1 = 0U; f.apb1 < 8U; f.apb1++) {
+                    for (f.apb2 = 0U; f.apb2 < 8U; f.apb2++) {
+                        tree_check(&f);
+                    }
+                }
+            }
+        }
+    }
+
+    // from the PLL: every PLL field combination, the prescalers and SCS rotate through
+    // all of their combinations along the way
+    f.scss = 2U;
+    for (f.pllsel = 0U; f.pllsel < 2U; f.pllsel++) {
+        for (f.pllmf = 0U; f.pllmf < 32U; f.pllmf++) {
+            for (f.predv0sel = 0U; f.predv0sel < 2U; f.predv0sel++) {
+                for (f.predv0 = 0U; f.predv0 < 16U; f.predv0++) {
+                    for (f.predv1 = 0U; f.predv1 < 16U; f.predv1++) {
+                        for (f.pll1mf = 0U; f.pll1mf < 16U; f.pll1mf++) {
+                            f.apb2 = bus % 8U;
+                            f.apb1 = (bus / 8U) % 8U;
+                            f.ahb = (bus / 64U) % 16U;
+                            f.scs = (bus / 1024U) % 4U;
+                            bus++;
+                            tree_check(&f);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("clock tree, HXTAL %u Hz: %u settings match (%u with rounding dividers), %u skipped, %u bad\n",
+           HXTAL_VALUE, tree_checked, tree_rounded, tree_skipped, tree_bad);
+    return (0U == tree_bad) ? 0 : 1;
+}